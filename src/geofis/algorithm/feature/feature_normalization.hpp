@@ -43,6 +43,9 @@
 #include <boost/range.hpp>
 #include <boost/range/combine.hpp>
 #include <boost/range/algorithm/for_each.hpp>
+#include <boost/range/algorithm/copy.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/version.hpp>
 #if BOOST_VERSION <= 107300
 #include <boost/function_output_iterator.hpp>
@@ -159,6 +162,7 @@ private:
 template <class Feature> class feature_normalization<Feature, boost::false_type> {
 
 	typedef typename Feature::attribute_type attribute_type;
+	typedef typename Feature::attribute_block_type attribute_block_type;
 
 public:
 	feature_normalization() {}
@@ -168,8 +172,15 @@ public:
 		return initialize_with_attribute_range(make_attribute_range(features));
 	}
 
-	template <class FeatureRange> void normalize(FeatureRange &features) {
-		normalize_to_function(features, detail::make_feature_updater<boost::false_type>(boost::begin(features)));
+	// the normalized attributes of the features are written in a single attribute block, one row per feature
+	template <class FeatureRange> void normalize(FeatureRange &features) const {
+		typedef typename boost::range_iterator<FeatureRange>::type feature_iterator_type;
+		boost::shared_ptr<attribute_block_type> normalized_attribute_block = boost::make_shared<attribute_block_type>(boost::size(features), normalizers.size());
+		size_t index = 0;
+		for(feature_iterator_type feature = boost::begin(features); feature != boost::end(features); ++feature, ++index) {
+			normalize_to_row(feature->get_attribute_range(), normalized_attribute_block->get_row(index));
+			feature->set_normalized_attribute_block(normalized_attribute_block, index);
+		}
 	}
 
 	template <class FeatureRange, class UnaryFunction> void normalize_to_function(const FeatureRange &features, const UnaryFunction &function) const {
@@ -254,6 +265,11 @@ private:
 		const NormalizerRange &normalizers;
 	};
 
+	template <class AttributeRange2> void normalize_to_row(const AttributeRange2 &attributes, const typename attribute_block_type::row_range_type &row) const {
+		UTIL_REQUIRE(boost::size(attributes) == normalizers.size());
+		boost::copy(util::make_zipped_with(attribute_normalizer(), normalizers, attributes), boost::begin(row));
+	}
+
 	template <class NormalizerRange> normalizer<NormalizerRange> make_normalizer(const NormalizerRange &normalizers) const {
 		return normalizer<NormalizerRange>(normalizers);
 	}
@@ -43,6 +43,7 @@
 #include <boost/range.hpp>
 #include <geofis/algorithm/zoning/pair/zone_pair_distance_less.hpp>
 #include <geofis/algorithm/zoning/pair/zone_pair_distance_equal.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_queue.hpp>
 
 namespace geofis {
 
@@ -64,6 +65,22 @@ end
 
 @enduml
 
+@startuml
+
+title with zone_pair_queue\n
+
+start
+
+:copy **zone_pairs** top iterator to the **output**;
+note right
+	**zone_pairs** is an addressable min heap
+	ordered like the successive stable sorts above
+end note
+
+end
+
+@enduml
+
 */
 
 struct minimum_aggregation {
@@ -78,6 +95,11 @@ struct minimum_aggregation {
 	    for ( ; (zone_pair_iterator != end_zone_pair_iterator) && (zone_pair_distance_equal()(*zone_pair_iterator, zone_pairs.front())) ; ++zone_pair_iterator)
 	    	*output = zone_pair_iterator;
 	}
+
+	//! zone_pair_queue is already in merging order: only the minimum zone pair is copied to the output
+	template <class ZonePairIterator, class OutputIterator> void operator()(zone_pair_queue<ZonePairIterator> &zone_pairs, OutputIterator output) const {
+		*output = zone_pairs.top();
+	}
 };
 
 } // namespace geofis
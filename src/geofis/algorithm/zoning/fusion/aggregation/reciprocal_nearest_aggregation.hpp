@@ -0,0 +1,143 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef RECIPROCAL_NEAREST_AGGREGATION_HPP_
+#define RECIPROCAL_NEAREST_AGGREGATION_HPP_
+
+#include <list>
+#include <vector>
+#include <iterator>
+#include <unordered_map>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/algorithm/copy.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_queue.hpp>
+#include <geofis/algorithm/zoning/fusion/aggregation/minimum_aggregation.hpp>
+
+namespace geofis {
+
+/*
+
+@startuml
+
+title with zone_pair_queue\n
+
+start
+
+:find the nearest **zone_pair** of each zone in **zone_pairs**;
+note right
+	the nearest **zone_pair** of a zone is its first
+	incident **zone_pair** in **zone_pairs** merging order
+end note
+
+:copy the **zone_pairs** nearest of their both zones
+to the **output** in merging order;
+note right
+	these reciprocal nearest **zone_pairs** are disjoint,
+	the first one is **zone_pairs** top
+end note
+
+end
+
+@enduml
+
+*/
+
+/**
+ * Aggregation of all the reciprocal nearest zone pairs, merged in the same fusion round.
+ *
+ * For a reducible zone distance, a reciprocal nearest zone pair stays reciprocal nearest
+ * whatever the other fusions, so the fusions are the ones of minimum_aggregation (up to
+ * the order of the fusions at equal distance) once sorted by distance.
+ * With the zone neighborhood constraint, only the maximum zone distance is reducible:
+ * for the other zone distances the fusion process falls back to minimum_aggregation.
+ */
+struct reciprocal_nearest_aggregation {
+
+	//! all the zone pairs share the same zone: only the minimum zone pairs are copied to the output
+	template <class ZonePair, class OutputIterator> void operator()(std::list<ZonePair> &zone_pairs, OutputIterator output) const {
+		minimum_aggregation()(zone_pairs, output);
+	}
+
+	template <class ZonePairIterator, class OutputIterator> void operator()(zone_pair_queue<ZonePairIterator> &zone_pairs, OutputIterator output) const {
+
+		typedef typename std::iterator_traits<ZonePairIterator>::value_type zone_pair_type;
+		typedef typename zone_pair_type::zone_type zone_type;
+		typedef std::vector<ZonePairIterator> zone_pair_iterator_container_type;
+		typedef std::unordered_map<const zone_type *, ZonePairIterator> nearest_zone_pair_container_type;
+
+		zone_pair_iterator_container_type queue_zone_pairs;
+		zone_pairs.copy(std::back_inserter(queue_zone_pairs));
+		nearest_zone_pair_container_type nearest_zone_pairs;
+		for(ZonePairIterator zone_pair : queue_zone_pairs) {
+			update_nearest_zone_pair(nearest_zone_pairs, zone_pair->get_zone1(), zone_pair, zone_pairs);
+			update_nearest_zone_pair(nearest_zone_pairs, zone_pair->get_zone2(), zone_pair, zone_pairs);
+		}
+		zone_pair_iterator_container_type reciprocal_nearest_zone_pairs;
+		for(ZonePairIterator zone_pair : queue_zone_pairs)
+			if(is_nearest_zone_pair(nearest_zone_pairs, zone_pair->get_zone1(), zone_pair) && is_nearest_zone_pair(nearest_zone_pairs, zone_pair->get_zone2(), zone_pair))
+				reciprocal_nearest_zone_pairs.push_back(zone_pair);
+		boost::sort(reciprocal_nearest_zone_pairs, zone_pair_queue_less<ZonePairIterator>(zone_pairs));
+		boost::copy(reciprocal_nearest_zone_pairs, output);
+	}
+
+private:
+	template <class ZonePairIterator> struct zone_pair_queue_less {
+
+		zone_pair_queue_less(const zone_pair_queue<ZonePairIterator> &zone_pairs) : zone_pairs(zone_pairs) {}
+
+		bool operator()(ZonePairIterator lhs, ZonePairIterator rhs) const {
+			return zone_pairs.precedes(lhs, rhs);
+		}
+
+		const zone_pair_queue<ZonePairIterator> &zone_pairs;
+	};
+
+	template <class NearestZonePairContainer, class Zone, class ZonePairIterator> static void update_nearest_zone_pair(NearestZonePairContainer &nearest_zone_pairs, const Zone &zone, ZonePairIterator zone_pair, const zone_pair_queue<ZonePairIterator> &zone_pairs) {
+		typename NearestZonePairContainer::iterator nearest_zone_pair = nearest_zone_pairs.insert(std::make_pair(&zone, zone_pair)).first;
+		if(zone_pairs.precedes(zone_pair, nearest_zone_pair->second))
+			nearest_zone_pair->second = zone_pair;
+	}
+
+	template <class NearestZonePairContainer, class Zone, class ZonePairIterator> static bool is_nearest_zone_pair(const NearestZonePairContainer &nearest_zone_pairs, const Zone &zone, ZonePairIterator zone_pair) {
+		return nearest_zone_pairs.find(&zone)->second == zone_pair;
+	}
+};
+
+} // namespace geofis
+
+#endif /* RECIPROCAL_NEAREST_AGGREGATION_HPP_ */
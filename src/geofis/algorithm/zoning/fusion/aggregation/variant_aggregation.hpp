@@ -41,10 +41,11 @@
 
 #include <boost/variant.hpp>
 #include <geofis/algorithm/zoning/fusion/aggregation/minimum_aggregation.hpp>
+#include <geofis/algorithm/zoning/fusion/aggregation/reciprocal_nearest_aggregation.hpp>
 
 namespace geofis {
 
-typedef boost::variant<minimum_aggregation> variant_aggregation;
+typedef boost::variant<minimum_aggregation, reciprocal_nearest_aggregation> variant_aggregation;
 
 } // namespace geofis
 
@@ -0,0 +1,114 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H6D9AE51E_1718_472D_BFA6_B7BF519CD46A
+#define H6D9AE51E_1718_472D_BFA6_B7BF519CD46A
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <util/functional/distance/euclidean_distance.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/feature_distance.hpp>
+
+namespace geofis {
+
+/**
+@startuml
+
+title attribute_row_distance class diagram\n
+
+class attribute_row_distance<FeatureDistance> {
+	+ <<constructor>> attribute_row_distance(feature_distance: FeatureDistance)
+	+ operator()(lhs: double [1..n], rhs: double [1..n]) : double
+}
+
+note right of attribute_row_distance
+  distance between 2 rows of normalized attributes,
+  equal to the feature distance of features with
+  these normalized attributes, and non decreasing
+  with the difference of each attribute
+
+  only defined for the feature distances computed
+  on the attribute differences, i.e. with euclidean
+  attribute distances, see has_attribute_row_distance
+end note
+
+@enduml
+*/
+
+template <class FeatureDistance> struct has_attribute_row_distance : boost::false_type {};
+
+template <class FeatureDistance> struct attribute_row_distance;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// specialization of attribute_row_distance for multidimensional distance on the attribute rows
+
+template <class MultidimensionalDistance> struct has_attribute_row_distance<feature_distance<MultidimensionalDistance, void> > : boost::true_type {};
+
+template <class MultidimensionalDistance> struct attribute_row_distance<feature_distance<MultidimensionalDistance, void> > {
+
+	typedef feature_distance<MultidimensionalDistance, void> feature_distance_type;
+
+	attribute_row_distance(const feature_distance_type &row_feature_distance) : row_feature_distance(row_feature_distance) {}
+
+	template <class AttributeRow> double operator()(const AttributeRow &lhs, const AttributeRow &rhs) const {
+		return row_feature_distance.multidimensional_distance(lhs, rhs);
+	}
+
+	const feature_distance_type &row_feature_distance;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// specialization of attribute_row_distance for monodimensional euclidean distance
+
+template <> struct has_attribute_row_distance<feature_distance<void, util::euclidean_distance<double> > > : boost::true_type {};
+
+template <> struct attribute_row_distance<feature_distance<void, util::euclidean_distance<double> > > {
+
+	typedef feature_distance<void, util::euclidean_distance<double> > feature_distance_type;
+
+	attribute_row_distance(const feature_distance_type &) {}
+
+	template <class AttributeRow> double operator()(const AttributeRow &lhs, const AttributeRow &rhs) const {
+		return util::euclidean_distance<double>()(lhs.front(), rhs.front());
+	}
+};
+
+} // namespace geofis
+
+#endif // H6D9AE51E_1718_472D_BFA6_B7BF519CD46A
@@ -43,10 +43,13 @@
 #include <util/functional/distance/euclidean_distance.hpp>
 #include <base/fuzzy_distance.hpp>
 #include <util/functional/distance/none_distance.hpp>
+#include <util/functional/distance/tabulated_distance.hpp>
 
 namespace geofis {
 
-typedef boost::variant<util::euclidean_distance<double>, fispro::fuzzy_distance, util::none_distance<double> > variant_attribute_distance;
+typedef util::tabulated_distance<fispro::fuzzy_distance> tabulated_fuzzy_distance;
+
+typedef boost::variant<util::euclidean_distance<double>, fispro::fuzzy_distance, util::none_distance<double>, tabulated_fuzzy_distance> variant_attribute_distance;
 
 } // namespace geofis
 
@@ -43,10 +43,11 @@
 #include <util/functional/maximum.hpp>
 #include <util/functional/minimum.hpp>
 #include <util/functional/mean.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/ward_zone_distance.hpp>
 
 namespace geofis {
 
-typedef boost::variant<util::minimum<double>, util::maximum<double>, util::mean<double> > variant_zone_distance;
+typedef boost::variant<util::minimum<double>, util::maximum<double>, util::mean<double>, ward_zone_distance> variant_zone_distance;
 
 } // namespace geofis
 
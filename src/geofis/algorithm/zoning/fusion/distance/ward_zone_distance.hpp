@@ -0,0 +1,64 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H2110DCF7_6B72_4E3C_B627_6C3039F6EDF8
+#define H2110DCF7_6B72_4E3C_B627_6C3039F6EDF8
+
+namespace geofis {
+
+/*
+@startuml
+
+class ward_zone_distance
+
+note right of ward_zone_distance
+	increase of the sum of squares of the zones when they are merged
+	n1 * n2 / (n1 + n2) * ||mean1 - mean2||^2
+	computed on the zone sizes and the means of the normalized attributes,
+	the attribute and multidimensional distances are not used
+end note
+
+@enduml
+*/
+
+//! \brief Tag of the Ward zone distance, see zone_pair_distance<ward_zone_distance>
+struct ward_zone_distance {};
+
+} // namespace geofis
+
+#endif // H2110DCF7_6B72_4E3C_B627_6C3039F6EDF8
@@ -40,7 +40,6 @@
 #define H7E8D391A_3C76_486A_A2DB_EDC05B49182D
 
 #include <geofis/algorithm/zoning/pair/zone_pair_distance.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair_feature_distance.hpp>
 #include <geofis/algorithm/zoning/fusion/distance/feature_distance.hpp>
 #include <util/functional/binary_adaptor.hpp>
 
@@ -67,7 +66,7 @@ public:
 	template<class MultidimensionalDistance, class AttributeDistanceRange> zone_distance_adapter(const ZoneDistance &zone_distance, const MultidimensionalDistance &multidimensional_distance, const AttributeDistanceRange &attribute_distances) : zone_distance(zone_distance), feature_distance(make_feature_distance<FeatureDistance>(multidimensional_distance, attribute_distances)) {}
 
 	template <class Zone> result_type operator()(const Zone &lhs, const Zone &rhs) const {
-		zone_pair_distance_type zone_pair_distance(zone_distance, make_zone_pair_feature_distance(lhs, rhs, feature_distance));
+		zone_pair_distance_type zone_pair_distance(zone_distance, lhs, rhs, feature_distance);
 		return zone_pair_distance.get_distance();
 	}
 
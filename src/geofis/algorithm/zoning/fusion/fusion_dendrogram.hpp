@@ -0,0 +1,223 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef HB106CAE1_A0F2_4DA7_B1FB_F632467C6409
+#define HB106CAE1_A0F2_4DA7_B1FB_F632467C6409
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdlib>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include <boost/range.hpp>
+#include <util/assert.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title fusion_dendrogram class diagram
+
+class fusion_dendrogram {
+	- leaf_size : size_t
+	- merges : int [0..*]
+	- heights : double [0..*]
+	- distances : double [0..*]
+	- labels : string [0..*]
+	+ <<constructor>> fusion_dendrogram(zones: Zone [1..*], fusions: zone_fusion [0..*])
+	+ get_leaf_size() : size_t
+	+ get_merge_size() : size_t
+	+ get_merges() : int [0..*]
+	+ get_heights() : double [0..*]
+	+ get_distances() : double [0..*]
+	+ get_labels() : string [0..*]
+	+ get_order() : int [0..*]
+}
+
+note right of fusion_dendrogram
+	the merges follow the stats::hclust convention,
+	indexes start at 1: the initial zone j is -j
+	and the zone built by the fusion k is k,
+	a leaf is written before a fusion zone
+
+	the heights are the cumulative maximum of the fusion heights,
+	so they are sorted as stats::cutree requires, a fusion of
+	a non ultrametric zone distance can be lower than a previous one,
+	the **distances** are the zone pair distances of the fusions, unraised
+
+	**merges** is a column major (merge size x 2) matrix,
+	so it is copied as is in an R integer matrix
+
+	the dendrogram is built in one pass over the fusions,
+	without any fusion map or zone geometry
+end note
+
+@enduml
+*/
+
+class fusion_dendrogram {
+
+	typedef std::vector<int> merge_container_type;
+	typedef std::vector<double> height_container_type;
+	typedef std::vector<std::string> label_container_type;
+	typedef std::vector<int> order_container_type;
+
+public:
+	fusion_dendrogram() : leaf_size(0) {}
+
+	template <class ZoneRange, class FusionRange> fusion_dendrogram(ZoneRange &zones, const FusionRange &fusions) : leaf_size(boost::size(zones)), merges(2 * boost::size(fusions)), heights(boost::size(fusions)), distances(boost::size(fusions)) {
+
+		typedef typename boost::range_value<FusionRange>::type zone_fusion_type;
+		typedef typename zone_fusion_type::zone_type zone_type;
+		typedef std::unordered_map<const zone_type *, int> node_container_type;
+
+		node_container_type nodes(leaf_size);
+		labels.reserve(leaf_size);
+		int leaf = 0;
+		for(const zone_type &zone : zones) {
+			nodes[&zone] = -(++leaf);
+			labels.push_back(zone.get_id());
+		}
+		size_t merge_size = get_merge_size();
+		int fusion = 0;
+		double height = -std::numeric_limits<double>::infinity();
+		for(const zone_fusion_type &zone_fusion : fusions) {
+			int node1 = pop_node(nodes, zone_fusion.get_zone1());
+			int node2 = pop_node(nodes, zone_fusion.get_zone2());
+			if(node_less()(node2, node1))
+				std::swap(node1, node2);
+			merges[fusion] = node1;
+			merges[merge_size + fusion] = node2;
+			height = std::max(height, zone_fusion.get_height());
+			heights[fusion] = height;
+			distances[fusion] = zone_fusion.get_distance();
+			nodes[&zone_fusion.get_fusion()] = ++fusion;
+		}
+	}
+
+	size_t get_leaf_size() const {
+		return leaf_size;
+	}
+
+	size_t get_merge_size() const {
+		return heights.size();
+	}
+
+	const merge_container_type &get_merges() const {
+		return merges;
+	}
+
+	const height_container_type &get_heights() const {
+		return heights;
+	}
+
+	const height_container_type &get_distances() const {
+		return distances;
+	}
+
+	const label_container_type &get_labels() const {
+		return labels;
+	}
+
+	// leaf order of a dendrogram plot without crossing branches, the zones which are not merged are the last roots
+	order_container_type get_order() const {
+		size_t merge_size = get_merge_size();
+		std::vector<bool> merged_fusions(merge_size, false);
+		std::vector<bool> merged_leaves(leaf_size, false);
+		for(int node : merges) {
+			if(node < 0)
+				merged_leaves[-node - 1] = true;
+			else
+				merged_fusions[node - 1] = true;
+		}
+		order_container_type order;
+		order.reserve(leaf_size);
+		for(size_t fusion = merge_size; fusion > 0; --fusion)
+			if(!merged_fusions[fusion - 1])
+				push_leaves(fusion, order);
+		for(size_t leaf = 0; leaf < leaf_size; ++leaf)
+			if(!merged_leaves[leaf])
+				order.push_back(leaf + 1);
+		return order;
+	}
+
+private:
+	size_t leaf_size;
+	merge_container_type merges;
+	height_container_type heights;
+	height_container_type distances;
+	label_container_type labels;
+
+	struct node_less {
+
+		bool operator()(int lhs, int rhs) const {
+			return std::make_pair(lhs > 0, std::abs(lhs)) < std::make_pair(rhs > 0, std::abs(rhs));
+		}
+	};
+
+	template <class NodeContainer, class Zone> static int pop_node(NodeContainer &nodes, const Zone &zone) {
+		typename NodeContainer::iterator node = nodes.find(&zone);
+		UTIL_REQUIRE(node != nodes.end());
+		int index = node->second;
+		nodes.erase(node);
+		return index;
+	}
+
+	// depth first traversal with an explicit stack, the dendrogram depth can reach the leaf size
+	void push_leaves(int fusion, order_container_type &order) const {
+		size_t merge_size = get_merge_size();
+		std::vector<int> nodes(1, fusion);
+		while(!nodes.empty()) {
+			int node = nodes.back();
+			nodes.pop_back();
+			if(node < 0)
+				order.push_back(-node);
+			else {
+				nodes.push_back(merges[merge_size + node - 1]);
+				nodes.push_back(merges[node - 1]);
+			}
+		}
+	}
+};
+
+} // namespace geofis
+
+#endif // HB106CAE1_A0F2_4DA7_B1FB_F632467C6409
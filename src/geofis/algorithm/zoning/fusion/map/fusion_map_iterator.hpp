@@ -39,11 +39,12 @@
 #ifndef FUSION_MAP_ITERATOR_HPP_
 #define FUSION_MAP_ITERATOR_HPP_
 
-#include <list>
-#include <boost/ref.hpp>
+#include <vector>
+#include <unordered_map>
 #include <boost/iterator/iterator_adaptor.hpp>
-#include <boost/range/algorithm/find_if.hpp>
-#include <util/address_equal.hpp>
+#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/adaptor/indirected.hpp>
+#include <boost/range/algorithm_ext/erase.hpp>
 #include <geofis/algorithm/zoning/fusion/map/fusion_map.hpp>
 
 namespace geofis {
@@ -56,8 +57,8 @@ template <class FusionIterator> struct fusion_map_iterator_traits {
 
 	typedef typename std::iterator_traits<FusionIterator>::value_type fusion_type;
 	typedef typename fusion_type::zone_type zone_type;
-	typedef boost::reference_wrapper<zone_type> zone_reference_type;
-	typedef std::list<zone_reference_type> zone_reference_container_type;
+	typedef std::vector<zone_type *> zone_slot_container_type;
+	typedef std::unordered_map<const zone_type *, size_t> zone_slot_index_container_type;
 	typedef fusion_map<zone_type> fusion_map_type;
 	typedef fusion_map_iterator<FusionIterator> fusion_map_iterator_type;
 	typedef boost::iterator_adaptor<fusion_map_iterator_type, FusionIterator, fusion_map_type, boost::use_default, fusion_map_type> base_type;
@@ -65,29 +66,69 @@ template <class FusionIterator> struct fusion_map_iterator_traits {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/*
+@startuml
+
+title fusion_map_iterator class diagram
+
+class fusion_map_iterator<FusionIterator> {
+	- zone_slots : zone * [0..*]
+	- zone_slot_indexes : unordered_map<const zone *, size_t>
+}
+
+note right of fusion_map_iterator
+	the zones of the current map are the non null **zone_slots**,
+	in the order of the previous list of zone references:
+	a fusion clears the slots of its zones and appends its own slot
+
+	**zone_slot_indexes** gives the slot of a zone in constant time,
+	so a fusion step is O(1) and the map k is reached in O(k),
+	the slots are compacted when half of them are cleared
+end note
+
+@enduml
+*/
+
 template <class FusionIterator> class fusion_map_iterator : public fusion_map_iterator_traits<FusionIterator>::base_type {
 
 	friend class boost::iterator_core_access;
 
 	typedef typename fusion_map_iterator_traits<FusionIterator>::base_type base_type;
+	typedef typename fusion_map_iterator_traits<FusionIterator>::zone_type zone_type;
 	typedef typename fusion_map_iterator_traits<FusionIterator>::fusion_map_type fusion_map_type;
-	typedef typename fusion_map_iterator_traits<FusionIterator>::zone_reference_container_type zone_reference_container_type;
+	typedef typename fusion_map_iterator_traits<FusionIterator>::zone_slot_container_type zone_slot_container_type;
+	typedef typename fusion_map_iterator_traits<FusionIterator>::zone_slot_index_container_type zone_slot_index_container_type;
 
 public:
 	fusion_map_iterator() : compute_zones(false) {}
 
-	template <class FusionRange, class ZoneRange> fusion_map_iterator(FusionRange &fusions, const ZoneRange &zones, bool compute_zones = false) : base_type(boost::begin(fusions)), begin(boost::begin(fusions)), end(boost::end(fusions)), zones(boost::begin(zones), boost::end(zones)), compute_zones(compute_zones) {
-		UTIL_REQUIRE(boost::size(zones) == boost::size(fusions) + 1);
-		increment_zones();
+	template <class FusionRange, class ZoneRange> fusion_map_iterator(FusionRange &fusions, const ZoneRange &zones, bool compute_zones = false) : base_type(boost::begin(fusions)), begin(boost::begin(fusions)), end(boost::end(fusions)), compute_zones(compute_zones) {
+		// the fusions can stop before a single zone remains
+		UTIL_REQUIRE(boost::size(zones) > boost::size(fusions));
+		zone_slots.reserve(boost::size(zones));
+		zone_slot_indexes.reserve(boost::size(zones));
+		for(const auto &zone : zones)
+			add_zone(boost::unwrap_ref(zone));
+		if(begin != end)
+			increment_zones();
 	}
 
 private:
 	FusionIterator begin;
 	FusionIterator end;
-	zone_reference_container_type zones;
+	zone_slot_container_type zone_slots;
+	zone_slot_index_container_type zone_slot_indexes;
 	bool compute_zones;
 
+	struct is_zone_slot_used {
+
+		bool operator()(const zone_type *zone) const {
+			return zone;
+		}
+	};
+
     typename base_type::reference dereference() const {
+    	auto zones = zone_slots | boost::adaptors::filtered(is_zone_slot_used()) | boost::adaptors::indirected;
 		return fusion_map_type(zones, *base_type::base(), compute_zones);
     }
 
@@ -115,9 +156,10 @@ private:
 	}
 
 	template <class Zone> void increment_zones(const Zone &zone1, const Zone &zone2, Zone &fusion) {
-		zones.erase(boost::find_if(zones, util::address_equal(zone1)));
-		zones.erase(boost::find_if(zones, util::address_equal(zone2)));
-		zones.push_back(boost::ref(fusion));
+		remove_zone(zone1);
+		remove_zone(zone2);
+		add_zone(fusion);
+		compact_zone_slots();
 	}
 
 	void decrement_zones() {
@@ -129,9 +171,31 @@ private:
 	}
 
 	template <class Zone> void decrement_zones(Zone &zone1, Zone &zone2, const Zone &fusion) {
-		zones.erase(boost::find_if(zones, util::address_equal(fusion)));
-		zones.push_back(boost::ref(zone1));
-		zones.push_back(boost::ref(zone2));
+		remove_zone(fusion);
+		add_zone(zone1);
+		add_zone(zone2);
+		compact_zone_slots();
+	}
+
+	void add_zone(zone_type &zone) {
+		zone_slot_indexes[&zone] = zone_slots.size();
+		zone_slots.push_back(&zone);
+	}
+
+	void remove_zone(const zone_type &zone) {
+		typename zone_slot_index_container_type::iterator zone_slot_index = zone_slot_indexes.find(&zone);
+		UTIL_REQUIRE(zone_slot_index != zone_slot_indexes.end());
+		zone_slots[zone_slot_index->second] = nullptr;
+		zone_slot_indexes.erase(zone_slot_index);
+	}
+
+	// the compaction is O(n) after at least n / 3 fusion steps, so a fusion step stays O(1) amortized
+	void compact_zone_slots() {
+		if(zone_slots.size() < 2 * zone_slot_indexes.size())
+			return;
+		boost::remove_erase(zone_slots, static_cast<zone_type *>(nullptr));
+		for(size_t zone_slot = 0; zone_slot < zone_slots.size(); ++zone_slot)
+			zone_slot_indexes[zone_slots[zone_slot]] = zone_slot;
 	}
 };
 
@@ -42,7 +42,6 @@
 #include <boost/ref.hpp>
 #include <geofis/algorithm/zoning/pair/zone_pair.hpp>
 #include <geofis/algorithm/zoning/pair/zone_pair_distance.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair_feature_distance.hpp>
 #include <util/functional/binary_reference_adaptor.hpp>
 
 namespace geofis {
@@ -55,7 +54,7 @@ template <class Zone, class ZoneDistance, class FeatureDistance> struct neighbor
 	neighbor_to_zone_pair(const ZoneDistance &zone_distance, const FeatureDistance &feature_distance) : zone_distance(zone_distance), feature_distance(feature_distance) {}
 
 	result_type make_zone_pair(Zone &zone1, Zone &zone2) const {
-		return result_type(zone1, zone2, make_zone_pair_distance(zone_distance, make_zone_pair_feature_distance(zone1, zone2, feature_distance)));
+		return result_type(zone1, zone2, make_zone_pair_distance(zone_distance, zone1, zone2, feature_distance));
 	}
 
 	template <class Neighbor> result_type operator()(Neighbor &neighbor) const {
@@ -0,0 +1,263 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H1D64D57B_D4DB_4977_A60C_505146C2AA24
+#define H1D64D57B_D4DB_4977_A60C_505146C2AA24
+
+#include <vector>
+#include <algorithm>
+#include <boost/range.hpp>
+#include <boost/next_prior.hpp>
+
+namespace geofis {
+
+/**
+@startuml
+
+title attribute_tree class diagram\n
+
+class attribute_tree<Feature> {
+	+ <<constructor>> attribute_tree(features: Feature [1..*])
+	+ size() : size_t
+	+ update_minimum_distance(feature: Feature, feature_distance: FeatureDistance, attribute_row_distance: AttributeRowDistance, minimum: double) : void
+	+ update_maximum_distance(feature: Feature, feature_distance: FeatureDistance, attribute_row_distance: AttributeRowDistance, maximum: double) : void
+}
+
+class node {
+	- begin : size_t
+	- end : size_t
+	- lower : double [1..n]
+	- upper : double [1..n]
+}
+
+hide node methods
+
+attribute_tree *-- "1..*\nnodes" node
+node o-- "0..2\nchildren" node
+
+note right of attribute_tree
+  k-d tree of the normalized attributes of the features,
+  a node splits its features at the median of the attribute
+  of largest extent, a leaf has at most **leaf_size** features
+
+  the box (**lower**, **upper**) of a node bounds the feature
+  distances between a feature and the node features with the
+  **attribute_row_distance** of the nearest and the farthest
+  box corner, the nodes that can not update the extremum
+  are pruned, so the extremum is the same as the one of all
+  the feature distances
+end note
+
+@enduml
+*/
+
+template <class Feature> class attribute_tree {
+
+	typedef std::vector<double> attribute_row_type;
+
+	struct node {
+
+		node(size_t begin, size_t end) : begin(begin), end(end), left(0), right(0) {}
+
+		bool is_leaf() const {
+			return left == 0;
+		}
+
+		size_t begin;
+		size_t end;
+		size_t left;
+		size_t right;
+		attribute_row_type lower;
+		attribute_row_type upper;
+	};
+
+public:
+	typedef Feature feature_type;
+
+	//! maximum number of features of a leaf node
+	static const size_t leaf_size = 16;
+
+	template <class FeatureRange> attribute_tree(const FeatureRange &features) : dimension(0) {
+		for(const feature_type &feature : features)
+			this->features.push_back(&feature);
+		if(!this->features.empty()) {
+			dimension = boost::size(this->features.front()->get_normalized_attribute_range());
+			build(0, this->features.size());
+		}
+	}
+
+	size_t size() const {
+		return features.size();
+	}
+
+	//! update **minimum** with the feature distances between **feature** and the tree features
+	template <class FeatureDistance, class AttributeRowDistance> void update_minimum_distance(const feature_type &feature, const FeatureDistance &feature_distance, const AttributeRowDistance &attribute_row_distance, double &minimum) const {
+		if(features.empty())
+			return;
+		const attribute_row_type row = make_attribute_row(feature);
+		attribute_row_type corner(dimension);
+		if(get_lower_bound(nodes.front(), row, corner, attribute_row_distance) < minimum)
+			update_minimum_distance(nodes.front(), feature, row, corner, feature_distance, attribute_row_distance, minimum);
+	}
+
+	//! update **maximum** with the feature distances between **feature** and the tree features
+	template <class FeatureDistance, class AttributeRowDistance> void update_maximum_distance(const feature_type &feature, const FeatureDistance &feature_distance, const AttributeRowDistance &attribute_row_distance, double &maximum) const {
+		if(features.empty())
+			return;
+		const attribute_row_type row = make_attribute_row(feature);
+		attribute_row_type corner(dimension);
+		if(get_upper_bound(nodes.front(), row, corner, attribute_row_distance) > maximum)
+			update_maximum_distance(nodes.front(), feature, row, corner, feature_distance, attribute_row_distance, maximum);
+	}
+
+private:
+	std::vector<const feature_type *> features;
+	std::vector<node> nodes;
+	size_t dimension;
+
+	struct attribute_less {
+
+		attribute_less(size_t axis) : axis(axis) {}
+
+		bool operator()(const feature_type *lhs, const feature_type *rhs) const {
+			return get_attribute(*lhs, axis) < get_attribute(*rhs, axis);
+		}
+
+		size_t axis;
+	};
+
+	static double get_attribute(const feature_type &feature, size_t axis) {
+		return *boost::next(boost::begin(feature.get_normalized_attribute_range()), axis);
+	}
+
+	static attribute_row_type make_attribute_row(const feature_type &feature) {
+		return attribute_row_type(boost::begin(feature.get_normalized_attribute_range()), boost::end(feature.get_normalized_attribute_range()));
+	}
+
+	// build the node of the features [begin, end) and its children, return the node index
+	size_t build(size_t begin, size_t end) {
+		size_t index = nodes.size();
+		nodes.push_back(node(begin, end));
+		compute_box(nodes.back());
+		if(end - begin > leaf_size) {
+			size_t middle = begin + (end - begin) / 2;
+			std::nth_element(features.begin() + begin, features.begin() + middle, features.begin() + end, attribute_less(get_largest_axis(nodes.back())));
+			size_t left = build(begin, middle);
+			size_t right = build(middle, end);
+			nodes[index].left = left;
+			nodes[index].right = right;
+		}
+		return index;
+	}
+
+	void compute_box(node &current) const {
+		current.lower = make_attribute_row(*features[current.begin]);
+		current.upper = current.lower;
+		for(size_t index = current.begin + 1; index < current.end; ++index) {
+			for(size_t axis = 0; axis < dimension; ++axis) {
+				double attribute = get_attribute(*features[index], axis);
+				current.lower[axis] = std::min(current.lower[axis], attribute);
+				current.upper[axis] = std::max(current.upper[axis], attribute);
+			}
+		}
+	}
+
+	size_t get_largest_axis(const node &current) const {
+		size_t largest_axis = 0;
+		for(size_t axis = 1; axis < dimension; ++axis)
+			if(current.upper[axis] - current.lower[axis] > current.upper[largest_axis] - current.lower[largest_axis])
+				largest_axis = axis;
+		return largest_axis;
+	}
+
+	// distance between **row** and the nearest point of the box of **current**
+	template <class AttributeRowDistance> double get_lower_bound(const node &current, const attribute_row_type &row, attribute_row_type &corner, const AttributeRowDistance &attribute_row_distance) const {
+		for(size_t axis = 0; axis < dimension; ++axis)
+			corner[axis] = std::min(std::max(row[axis], current.lower[axis]), current.upper[axis]);
+		return attribute_row_distance(row, corner);
+	}
+
+	// distance between **row** and the farthest corner of the box of **current**
+	template <class AttributeRowDistance> double get_upper_bound(const node &current, const attribute_row_type &row, attribute_row_type &corner, const AttributeRowDistance &attribute_row_distance) const {
+		for(size_t axis = 0; axis < dimension; ++axis)
+			corner[axis] = row[axis] - current.lower[axis] > current.upper[axis] - row[axis] ? current.lower[axis] : current.upper[axis];
+		return attribute_row_distance(row, corner);
+	}
+
+	// the nearer child is visited first, a child is pruned if its lower bound is not lower than **minimum**
+	template <class FeatureDistance, class AttributeRowDistance> void update_minimum_distance(const node &current, const feature_type &feature, const attribute_row_type &row, attribute_row_type &corner, const FeatureDistance &feature_distance, const AttributeRowDistance &attribute_row_distance, double &minimum) const {
+		if(current.is_leaf()) {
+			for(size_t index = current.begin; index < current.end; ++index)
+				minimum = std::min(minimum, double(feature_distance(feature, *features[index])));
+			return;
+		}
+		const node &left = nodes[current.left];
+		const node &right = nodes[current.right];
+		double left_bound = get_lower_bound(left, row, corner, attribute_row_distance);
+		double right_bound = get_lower_bound(right, row, corner, attribute_row_distance);
+		const node &first = left_bound <= right_bound ? left : right;
+		const node &second = left_bound <= right_bound ? right : left;
+		if(std::min(left_bound, right_bound) < minimum)
+			update_minimum_distance(first, feature, row, corner, feature_distance, attribute_row_distance, minimum);
+		if(std::max(left_bound, right_bound) < minimum)
+			update_minimum_distance(second, feature, row, corner, feature_distance, attribute_row_distance, minimum);
+	}
+
+	// the farther child is visited first, a child is pruned if its upper bound is not greater than **maximum**
+	template <class FeatureDistance, class AttributeRowDistance> void update_maximum_distance(const node &current, const feature_type &feature, const attribute_row_type &row, attribute_row_type &corner, const FeatureDistance &feature_distance, const AttributeRowDistance &attribute_row_distance, double &maximum) const {
+		if(current.is_leaf()) {
+			for(size_t index = current.begin; index < current.end; ++index)
+				maximum = std::max(maximum, double(feature_distance(feature, *features[index])));
+			return;
+		}
+		const node &left = nodes[current.left];
+		const node &right = nodes[current.right];
+		double left_bound = get_upper_bound(left, row, corner, attribute_row_distance);
+		double right_bound = get_upper_bound(right, row, corner, attribute_row_distance);
+		const node &first = left_bound >= right_bound ? left : right;
+		const node &second = left_bound >= right_bound ? right : left;
+		if(std::max(left_bound, right_bound) > maximum)
+			update_maximum_distance(first, feature, row, corner, feature_distance, attribute_row_distance, maximum);
+		if(std::min(left_bound, right_bound) > maximum)
+			update_maximum_distance(second, feature, row, corner, feature_distance, attribute_row_distance, maximum);
+	}
+};
+
+} // namespace geofis
+
+#endif // H1D64D57B_D4DB_4977_A60C_505146C2AA24
@@ -0,0 +1,204 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef VORONOI_ZONE_LIST_HPP_
+#define VORONOI_ZONE_LIST_HPP_
+
+#include <utility>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <util/assert.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title voronoi_zone_list class diagram\n
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+interface VoronoiZone {
+}
+
+hide VoronoiZone members
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+class node {
+	- next : node
+}
+
+hide node methods
+
+node o-- "voronoi_zone" VoronoiZone
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+class voronoi_zone_list<VoronoiZone> {
+	- count : size_t
+	+ <<constructor>> voronoi_zone_list(voronoi_zone: VoronoiZone)
+	+ <<constructor>> voronoi_zone_list(list1: voronoi_zone_list, list2: voronoi_zone_list)
+	+ append(list: voronoi_zone_list) : void
+	+ begin() : const_iterator
+	+ end() : const_iterator
+}
+
+show voronoi_zone_list methods
+
+voronoi_zone_list o-- "1..n\nsegments (first, last)" node
+voronoi_zone_list *-- "0..1\nleaf" node
+
+note right of voronoi_zone_list
+	each voronoi zone has a single node
+	a fusion links the last node of list1
+	to the first node of list2, so its list
+	is a single segment sharing the nodes
+	of the merged lists
+end note
+
+@enduml
+*/
+
+/**
+ * Persistent linked list of voronoi zones.
+ *
+ * A leaf list owns the node of its voronoi zone, the other lists are segments (first, last)
+ * of linked nodes owned by the leaf lists. Each zone is merged once in a fusion process,
+ * so the next link of the last node of a list is set at most once and the fused lists
+ * remain valid: a fusion costs O(1) in time and memory, and the iteration is O(size).
+ */
+template <class VoronoiZone> class voronoi_zone_list {
+
+	struct node {
+
+		node(const VoronoiZone &voronoi_zone) : voronoi_zone(voronoi_zone), next(nullptr) {}
+
+		const VoronoiZone &voronoi_zone;
+		node *next;
+	};
+
+	typedef std::pair<node *, node *> segment_type;
+	typedef boost::container::small_vector<segment_type, 1> segment_container_type;
+	typedef typename segment_container_type::const_iterator segment_iterator_type;
+
+public:
+	class const_iterator : public boost::iterator_facade<const_iterator, const VoronoiZone, boost::forward_traversal_tag> {
+
+		friend class boost::iterator_core_access;
+
+	public:
+		const_iterator() : current(nullptr) {}
+		const_iterator(segment_iterator_type segment, segment_iterator_type end_segment) : segment(segment), end_segment(end_segment), current(segment != end_segment ? segment->first : nullptr) {}
+
+	private:
+		segment_iterator_type segment;
+		segment_iterator_type end_segment;
+		const node *current;
+
+		const VoronoiZone &dereference() const {
+			return current->voronoi_zone;
+		}
+
+		void increment() {
+			if(current != segment->second)
+				current = current->next;
+			else if(++segment != end_segment)
+				current = segment->first;
+			else
+				current = nullptr;
+		}
+
+		bool equal(const const_iterator &other) const {
+			return current == other.current;
+		}
+	};
+
+	typedef const_iterator iterator;
+
+	voronoi_zone_list(const VoronoiZone &voronoi_zone) : leaf(boost::make_shared<node>(voronoi_zone)), segments(1, segment_type(leaf.get(), leaf.get())), count(1) {}
+
+	//! link list2 at the end of list1, the next link of the last node of list1 is overwritten
+	voronoi_zone_list(const voronoi_zone_list &list1, const voronoi_zone_list &list2) : count(list1.count + list2.count) {
+		if(list1.segments.size() == 1 && list2.segments.size() == 1) {
+			list1.segments.back().second->next = list2.segments.front().first;
+			segments.push_back(segment_type(list1.segments.front().first, list2.segments.back().second));
+		} else {
+			append_segments(list1);
+			append_segments(list2);
+		}
+	}
+
+	//! append the segments of list without linking them, the nodes are left unchanged
+	void append(const voronoi_zone_list &list) {
+		append_segments(list);
+		count += list.count;
+	}
+
+	const_iterator begin() const {
+		return const_iterator(segments.begin(), segments.end());
+	}
+
+	const_iterator end() const {
+		return const_iterator(segments.end(), segments.end());
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+private:
+	boost::shared_ptr<node> leaf;
+	segment_container_type segments;
+	size_t count;
+
+	void append_segments(const voronoi_zone_list &list) {
+		UTIL_ASSERT(!list.segments.empty());
+		segments.insert(segments.end(), list.segments.begin(), list.segments.end());
+	}
+};
+
+} // namespace geofis
+
+#endif /* VORONOI_ZONE_LIST_HPP_ */
@@ -41,22 +41,28 @@
 
 #include <vector>
 #include <cmath>
+#include <iterator>
+#include <algorithm>
+#include <functional>
 #include <util/assert.hpp>
 #include <boost/ref.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/next_prior.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm/copy.hpp>
 #include <boost/range/algorithm/transform.hpp>
 #include <boost/range/algorithm/for_each.hpp>
-#include <boost/range/algorithm/min_element.hpp>
 #include <boost/range/algorithm_ext/for_each.hpp>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
 #include <CGAL/Boolean_set_operations_2.h>
-#include <util/range/unwrap_range.hpp>
-#include <util/iterator/output/back_insert_reference_iterator.hpp>
+#include <geofis/algorithm/zoning/fusion/zone/voronoi_zone_list.hpp>
+#include <geofis/algorithm/zoning/fusion/zone/attribute_tree.hpp>
 #include <geofis/data/featurable.hpp>
 #include <geofis/geometry/geometrical.hpp>
+#include <geofis/geometry/halfedge/halfedge_dissolve.hpp>
 #include <geofis/geometry/area/geometry_area.hpp>
 #include <geofis/identifiable/identifiable_comparator.hpp>
 
@@ -64,6 +70,7 @@ namespace geofis {
 
 struct zone_attributes_computer;
 template <class ZoneFusion> class zone_geometry_computer;
+template <class ZoneFusion> class zone_geometry_cache;
 template <class Zone> class zone_area_computer;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -137,12 +144,17 @@ class zone<Geometry, VoronoiZone> {
 	+ get_variance(size_t) : double
 	+ get_standard_deviations() : standard_deviation_range_type
 	+ get_standard_deviation(size_t) : double
+	+ get_normalized_means() : double [1..n]
+	+ get_attribute_tree() : attribute_tree<Feature>
+	+ release_attribute_tree()
 	+ merge(Zone)
 	- set_area(area)
 	- has_geometry() : bool
 	- compute_geometry()
+	- clear_geometry()
 	- has_attributes() : bool
 	- compute_attributes()
+	- compute_normalized_means()
 }
 
 note right
@@ -151,23 +163,54 @@ note right
   set_area() is private, called by friend class zone_area_computer
 end note
 
+note left of zone::get_normalized_means
+  **normalized means optimisation**
+  the means of the normalized feature attributes are computed once,
+  then the means of a fusion or a merge are computed from the means
+  of its zones when they are already computed
+end note
+
+note left of zone::get_attribute_tree
+  **attribute tree optimisation**
+  the attribute tree of the features is built on first use,
+  then rebuilt on first use after a merge,
+  the fusion process releases the trees of the fused zones
+end note
+
+note left of zone::compute_geometry
+  **dissolve optimisation**
+  the geometry is dissolved from the voronoi polygons, which share their edges,
+  without any arrangement, CGAL::join is the fallback of a failed dissolve
+end note
+
+note left of zone::merge
+  **geometry optimisation**
+  the geometry of a merge is the join of the geometries of its zones
+  when both are already computed, otherwise it is computed on first use
+end note
+
 zone o-right- "1..n\nattribute_accumulators" accumulator_type
-zone o-down- "1..n\nvoronoi_zones" VoronoiZone
+zone *-down- "voronoi_zones" voronoi_zone_list
+voronoi_zone_list o-down- "1..n" VoronoiZone
 
 class zone_area_computer<Zone>
 class zone_geometry_computer<ZoneFusion>
+class zone_geometry_cache<ZoneFusion>
 class zone_attributes_computer
 
 zone <.right. zone_area_computer : <<friend>>
 zone <.right. zone_geometry_computer : <<friend>>
+zone <.right. zone_geometry_cache : <<friend>>
 zone <.right. zone_attributes_computer : <<friend>>
 
 hide accumulator_type members
 hide accumulator_set members
+hide voronoi_zone_list members
 hide VoronoiZone members
 show VoronoiZone methods
 hide zone_area_computer members
 hide zone_geometry_computer members
+hide zone_geometry_cache members
 hide zone_attributes_computer members
 
 @enduml
@@ -177,6 +220,7 @@ template <class Geometry, class VoronoiZone> class zone {
 
 	friend zone_attributes_computer;
 	template <class ZoneFusion> friend class zone_geometry_computer;
+	template <class ZoneFusion> friend class zone_geometry_cache;
 	template <class Zone> friend class zone_area_computer;
 
 public:
@@ -185,11 +229,11 @@ public:
 	typedef VoronoiZone voronoi_zone_type;
 	typedef typename VoronoiZone::feature_type feature_type;
 	typedef boost::optional<double> area_type;
+	typedef attribute_tree<feature_type> attribute_tree_type;
 
 private:
 	typedef boost::optional<geometry_type> optional_geometry_type;
-	typedef boost::reference_wrapper<const voronoi_zone_type> voronoi_zone_reference_type;
-	typedef std::vector<voronoi_zone_reference_type> voronoi_zone_reference_container_type;
+	typedef voronoi_zone_list<voronoi_zone_type> voronoi_zone_container_type;
 	typedef boost::accumulators::accumulator_set<double, boost::accumulators::features<boost::accumulators::tag::variance> > accumulator_type;
 	typedef std::vector<accumulator_type> accumulator_container_type;
 	typedef accumulator_extractor<boost::accumulators::tag::mean> accumulator_extractor_mean_type;
@@ -197,16 +241,15 @@ private:
 	typedef boost::transformed_range<accumulator_extractor_mean_type, const accumulator_container_type> mean_range_type;
 	typedef boost::transformed_range<accumulator_extractor_variance_type, const accumulator_container_type> variance_range_type;
 	typedef boost::transformed_range<standard_deviation_extractor, const accumulator_container_type> standard_deviation_range_type;
+	typedef std::vector<double> normalized_mean_container_type;
 
 public:
-	typedef typename util::unwrap_range_traits<const voronoi_zone_reference_container_type>::unwrap_range_type voronoi_zone_range_type;
+	typedef boost::iterator_range<typename voronoi_zone_container_type::const_iterator> voronoi_zone_range_type;
 	typedef typename featurable_range_traits<const voronoi_zone_range_type>::feature_range_type feature_range_type;
 
-	zone(const voronoi_zone_type &voronoi_zone) : id(voronoi_zone.get_id()), voronoi_zones(1, boost::cref(voronoi_zone)) {}
-	template <class VoronoiZoneRange> zone(const VoronoiZoneRange &voronoi_zones) : voronoi_zones(boost::begin(voronoi_zones), boost::end(voronoi_zones)) {
-		UTIL_REQUIRE(!get_voronoi_zones().empty());
-		id = boost::min_element(get_voronoi_zones(), identifiable_comparator())->get_id();
-	}
+	zone(const voronoi_zone_type &voronoi_zone) : id(voronoi_zone.get_id()), voronoi_zones(voronoi_zone) {}
+	//! fusion of zone1 and zone2, the voronoi zones are shared with zone1 and zone2
+	zone(const zone &zone1, const zone &zone2) : id(std::min(zone1, zone2, identifiable_comparator()).get_id()), voronoi_zones(zone1.voronoi_zones, zone2.voronoi_zones), normalized_means(merge_normalized_means(zone1, zone2)) {}
 
 	id_type get_id() const {
 		return id;
@@ -222,11 +265,12 @@ public:
 	}
 
 	const voronoi_zone_type &get_voronoi_zone(size_t index) const {
-		return voronoi_zones.at(index);
+		UTIL_REQUIRE(index < size());
+		return *boost::next(boost::begin(voronoi_zones), index);
 	}
 
 	voronoi_zone_range_type get_voronoi_zones() const {
-		return util::make_unwrap_range(voronoi_zones);
+		return boost::make_iterator_range(voronoi_zones);
 	}
 
 	const feature_type &get_feature(size_t index) const {
@@ -279,21 +323,41 @@ public:
 		return boost::adaptors::transform(attribute_accumulators, standard_deviation_extractor());
 	}
 
+	//! means of the normalized attributes of the features, not thread safe on the first call
+	const normalized_mean_container_type &get_normalized_means() const {
+		const_cast<zone *>(this)->compute_normalized_means();
+		return normalized_means;
+	}
+
+	//! k-d tree of the normalized attributes of the features, not thread safe on the first call
+	const attribute_tree_type &get_attribute_tree() const {
+		const_cast<zone *>(this)->compute_attribute_tree();
+		return *normalized_attribute_tree;
+	}
+
+	void release_attribute_tree() {
+		normalized_attribute_tree.reset();
+	}
+
 	void merge(const zone &merged_zone) {
-		boost::copy(merged_zone.get_voronoi_zones(), util::back_inserter_reference(voronoi_zones));
-		id = boost::min_element(get_voronoi_zones(), identifiable_comparator())->get_id();
+		normalized_means = merge_normalized_means(*this, merged_zone);
+		voronoi_zones.append(merged_zone.voronoi_zones);
+		id = std::min(*this, merged_zone, identifiable_comparator()).get_id();
 		if(area)
 			area = area.get() + merged_zone.get_area();
-		geometry = boost::none;
+		merge_geometry(merged_zone);
 		attribute_accumulators.clear();
+		normalized_attribute_tree.reset();
 	}
 
 private:
 	id_type id;
 	area_type area;
-	voronoi_zone_reference_container_type voronoi_zones;
+	voronoi_zone_container_type voronoi_zones;
 	optional_geometry_type geometry;
 	accumulator_container_type attribute_accumulators;
+	normalized_mean_container_type normalized_means;
+	boost::shared_ptr<const attribute_tree_type> normalized_attribute_tree;
 
 	void set_area(double area) {
 		this->area = area;
@@ -308,6 +372,16 @@ private:
 			accumulate_voronoi_zones();
 	}
 
+	void compute_normalized_means() {
+		if(normalized_means.empty())
+			accumulate_normalized_means();
+	}
+
+	void compute_attribute_tree() {
+		if(!normalized_attribute_tree)
+			normalized_attribute_tree = boost::make_shared<attribute_tree_type>(get_feature_range());
+	}
+
 	bool has_geometry() const { return geometry.is_initialized(); }
 
 	void compute_geometry() {
@@ -315,6 +389,18 @@ private:
 			compute_geometry(make_geometry_range(get_voronoi_zones()));
 	}
 
+	void clear_geometry() {
+		geometry = boost::none;
+	}
+
+	void merge_geometry(const zone &merged_zone) {
+		geometry_type join_result;
+		if(geometry && merged_zone.geometry && join_geometries(geometry.get(), merged_zone.geometry.get(), join_result))
+			geometry = join_result;
+		else
+			geometry = boost::none;
+	}
+
 	template <class Extractor> double extract(const Extractor &extractor, size_t pos) const {
 		return extract(extractor, attribute_accumulators.at(pos));
 	}
@@ -324,6 +410,11 @@ private:
 	}
 
 	template <class GeometryRange> void compute_geometry(const GeometryRange &geometries) {
+		geometry_type dissolve_result;
+		if(dissolve_geometries(geometries, dissolve_result)) {
+			geometry = dissolve_result;
+			return;
+		}
 		std::vector<geometry_type> result_join_geometries;
 		CGAL::join(boost::begin(geometries), boost::end(geometries), std::back_inserter(result_join_geometries));
 		UTIL_ASSERT(result_join_geometries.size() == 1);
@@ -369,6 +460,38 @@ private:
 	void accumulate_voronoi_zones() {
 		boost::for_each(voronoi_zones, accumulate_voronoi_zone(attribute_accumulators));
 	}
+
+	void accumulate_normalized_means() {
+		for(const feature_type &feature : get_feature_range()) {
+			if(normalized_means.empty())
+				normalized_means.assign(boost::begin(feature.get_normalized_attribute_range()), boost::end(feature.get_normalized_attribute_range()));
+			else
+				boost::transform(normalized_means, feature.get_normalized_attribute_range(), boost::begin(normalized_means), std::plus<double>());
+		}
+		double size = this->size();
+		for(double &normalized_mean : normalized_means)
+			normalized_mean /= size;
+	}
+
+	struct weighted_mean {
+
+		weighted_mean(double size1, double size2) : size1(size1), size2(size2) {}
+
+		double operator()(double mean1, double mean2) const {
+			return (size1 * mean1 + size2 * mean2) / (size1 + size2);
+		}
+
+		double size1;
+		double size2;
+	};
+
+	// the means of zone1 and zone2 merged, empty if the means of zone1 or zone2 are not computed
+	static normalized_mean_container_type merge_normalized_means(const zone &zone1, const zone &zone2) {
+		normalized_mean_container_type normalized_means;
+		if(!zone1.normalized_means.empty() && !zone2.normalized_means.empty())
+			boost::transform(zone1.normalized_means, zone2.normalized_means, std::back_inserter(normalized_means), weighted_mean(zone1.size(), zone2.size()));
+		return normalized_means;
+	}
 };
 
 } // namespace geofis
@@ -0,0 +1,361 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef HC87732CB_3E84_4D55_BD4D_6BF4985884A8
+#define HC87732CB_3E84_4D55_BD4D_6BF4985884A8
+
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <boost/range.hpp>
+#include <boost/next_prior.hpp>
+#include <CGAL/Boolean_set_operations_2.h>
+#include <util/algorithm/parallel_for_each_chunk.hpp>
+#include <geofis/geometry/unshared_geometry.hpp>
+#include <geofis/geometry/halfedge/halfedge_dissolve.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title zone_geometry_cache class diagram
+
+class zone_geometry_cache<ZoneFusion> {
+	- zone_fusions : unordered_map<const Zone *, ZoneFusion *>
+	- parent_fusions : unordered_map<const Zone *, ZoneFusion *>
+	- cached_fusions : ZoneFusion * [0..*]
+	- vertex_limit : size_t
+	- vertex_size : size_t
+	+ <<constructor>> zone_geometry_cache(zone_fusions: ZoneFusion [0..*], vertex_limit: size_t)
+	+ compute_geometry(zone: Zone)
+	+ compute_geometries(zones: Zone [0..*], thread_count: size_t)
+	+ get_vertex_size() : size_t
+}
+
+note right of zone_geometry_cache
+	the geometry of a fusion zone is the join of the geometries of its two zones,
+	computed bottom up in the fusion dendrogram, so each fusion costs one join
+	instead of a join of all its voronoi zones, the join dissolves the common
+	edges of the two geometries, CGAL::join is the fallback of a failed dissolve
+
+	**cached_fusions** is ordered from the least to the most recently used fusion,
+	when the vertices of the cached geometries exceed **vertex_limit**,
+	the least recently used geometries are cleared, except the zones
+	still needed by the fusions being computed, the zones of the range
+	being computed and the last computed one,
+	a cleared geometry is computed again on next use
+end note
+
+note bottom of zone_geometry_cache
+	the fusions below the zones of a map are disjoint, so with several threads
+	each zone of the range is joined in a **zone_geometry_task**:
+	the geometries of its computed zones are copied without shared lazy numbers,
+	the task joins its fusions on its own thread, then the joined geometries
+	are set and cached on the calling thread
+end note
+
+@enduml
+*/
+
+template <class ZoneFusion> class zone_geometry_cache {
+
+	typedef typename ZoneFusion::zone_type zone_type;
+	typedef typename zone_type::geometry_type geometry_type;
+	typedef std::unordered_map<const zone_type *, ZoneFusion *> zone_fusion_index_container_type;
+	typedef std::list<ZoneFusion *> cached_fusion_container_type;
+	typedef typename cached_fusion_container_type::iterator cached_fusion_iterator_type;
+
+	struct cached_fusion_info {
+		cached_fusion_iterator_type position;
+		size_t vertex_size;
+	};
+
+	typedef std::unordered_map<const ZoneFusion *, cached_fusion_info> cached_fusion_info_container_type;
+	typedef std::vector<ZoneFusion *> fusion_stack_type;
+	typedef std::unordered_set<const ZoneFusion *> stacked_fusion_container_type;
+	typedef std::unordered_set<const zone_type *> pinned_zone_container_type;
+	typedef std::unordered_map<const zone_type *, geometry_type> task_geometry_container_type;
+
+	struct zone_geometry_task {
+		//! uncomputed fusions below the zone, in post order
+		std::vector<ZoneFusion *> fusions;
+		//! unshared geometries of the computed zones, then of the joined fusions
+		task_geometry_container_type geometries;
+	};
+
+	typedef std::vector<zone_geometry_task> zone_geometry_task_container_type;
+	typedef std::vector<std::pair<ZoneFusion *, bool> > task_fusion_stack_type;
+
+	struct zone_geometry_task_joiner {
+
+		zone_geometry_task_container_type &tasks;
+		size_t chunk_count;
+
+		zone_geometry_task_joiner(zone_geometry_task_container_type &tasks, size_t chunk_count) : tasks(tasks), chunk_count(chunk_count) {}
+
+		// the tasks are sorted by decreasing size and dealt to the chunks in turn
+		void operator()(size_t chunk, size_t, size_t) const {
+			for(size_t task = chunk; task < tasks.size(); task += chunk_count)
+				join_task(tasks[task]);
+		}
+
+		void join_task(zone_geometry_task &task) const {
+			for(ZoneFusion *zone_fusion : task.fusions) {
+				typename task_geometry_container_type::const_iterator geometry1 = task.geometries.find(&zone_fusion->get_zone1());
+				typename task_geometry_container_type::const_iterator geometry2 = task.geometries.find(&zone_fusion->get_zone2());
+				geometry_type join_result;
+				// a fusion of disjoint zones is left to the calling thread, as the fusions above it
+				if(geometry1 == task.geometries.end() || geometry2 == task.geometries.end() || !join_geometries(geometry1->second, geometry2->second, join_result))
+					continue;
+				task.geometries[&zone_fusion->get_fusion()] = join_result;
+			}
+		}
+	};
+
+public:
+	template <class ZoneFusionRange> zone_geometry_cache(ZoneFusionRange &zone_fusions, size_t vertex_limit) : vertex_limit(vertex_limit), vertex_size(0) {
+		this->zone_fusions.reserve(boost::size(zone_fusions));
+		parent_fusions.reserve(2 * boost::size(zone_fusions));
+		for(ZoneFusion &zone_fusion : zone_fusions) {
+			this->zone_fusions[&zone_fusion.get_fusion()] = &zone_fusion;
+			parent_fusions[&zone_fusion.get_zone1()] = &zone_fusion;
+			parent_fusions[&zone_fusion.get_zone2()] = &zone_fusion;
+		}
+	}
+
+	//! computes the geometry of **zone**, a fusion zone is joined from the geometries of its zones, not thread safe
+	void compute_geometry(const zone_type &zone) {
+		ZoneFusion *zone_fusion = find_zone_fusion(zone);
+		if(!zone_fusion) {
+			zone.get_geometry();
+			return;
+		}
+		if(zone_fusion->get_fusion().has_geometry()) {
+			touch_fusion(*zone_fusion);
+			return;
+		}
+		push_fusion(*zone_fusion);
+		while(!fusion_stack.empty()) {
+			ZoneFusion &top_fusion = *fusion_stack.back();
+			ZoneFusion *uncomputed_fusion = find_uncomputed_fusion(top_fusion);
+			if(uncomputed_fusion)
+				push_fusion(*uncomputed_fusion);
+			else {
+				pop_fusion();
+				join_zones(top_fusion);
+				cache_fusion(top_fusion);
+				evict_fusions();
+			}
+		}
+	}
+
+	//! computes the geometries of **zones** with **thread_count** threads, none of them is cleared before all are computed, not thread safe
+	template <class ZoneRange> void compute_geometries(const ZoneRange &zones, size_t thread_count = 1) {
+		for(const zone_type &zone : zones)
+			pinned_zones.insert(&zone);
+		if(thread_count > 1)
+			compute_geometries_in_parallel(zones, thread_count);
+		for(const zone_type &zone : zones)
+			compute_geometry(zone);
+		pinned_zones.clear();
+		evict_fusions();
+	}
+
+	size_t get_vertex_size() const {
+		return vertex_size;
+	}
+
+private:
+	zone_fusion_index_container_type zone_fusions;
+	zone_fusion_index_container_type parent_fusions;
+	cached_fusion_container_type cached_fusions;
+	cached_fusion_info_container_type cached_fusion_infos;
+	fusion_stack_type fusion_stack;
+	stacked_fusion_container_type stacked_fusions;
+	pinned_zone_container_type pinned_zones;
+	size_t vertex_limit;
+	size_t vertex_size;
+
+	template <class ZoneRange> void compute_geometries_in_parallel(const ZoneRange &zones, size_t thread_count) {
+		zone_geometry_task_container_type tasks;
+		for(const zone_type &zone : zones)
+			if(find_uncomputed_fusion(zone))
+				tasks.push_back(zone_geometry_task());
+		if(tasks.size() < 2)
+			return;
+		typename zone_geometry_task_container_type::iterator task = tasks.begin();
+		for(const zone_type &zone : zones) {
+			ZoneFusion *zone_fusion = find_uncomputed_fusion(zone);
+			if(zone_fusion)
+				make_task(*task++, *zone_fusion);
+		}
+		std::sort(tasks.begin(), tasks.end(), [](const zone_geometry_task &task1, const zone_geometry_task &task2) { return task1.fusions.size() > task2.fusions.size(); });
+		size_t chunk_count = util::get_chunk_count(tasks.size(), thread_count);
+		util::parallel_for_each_chunk(chunk_count, thread_count, zone_geometry_task_joiner(tasks, chunk_count));
+		for(zone_geometry_task &task : tasks)
+			cache_task(task);
+	}
+
+	// collects the uncomputed fusions below **zone_fusion** in post order, and the unshared geometries of the computed zones they join
+	void make_task(zone_geometry_task &task, ZoneFusion &zone_fusion) {
+		task_fusion_stack_type task_fusion_stack(1, std::make_pair(&zone_fusion, false));
+		while(!task_fusion_stack.empty()) {
+			std::pair<ZoneFusion *, bool> task_fusion = task_fusion_stack.back();
+			task_fusion_stack.pop_back();
+			if(task_fusion.second)
+				task.fusions.push_back(task_fusion.first);
+			else {
+				task_fusion_stack.push_back(std::make_pair(task_fusion.first, true));
+				push_task_zone(task, task_fusion_stack, task_fusion.first->get_zone2());
+				push_task_zone(task, task_fusion_stack, task_fusion.first->get_zone1());
+			}
+		}
+	}
+
+	void push_task_zone(zone_geometry_task &task, task_fusion_stack_type &task_fusion_stack, const zone_type &zone) {
+		ZoneFusion *uncomputed_fusion = find_uncomputed_fusion(zone);
+		if(uncomputed_fusion)
+			task_fusion_stack.push_back(std::make_pair(uncomputed_fusion, false));
+		else {
+			task.geometries[&zone] = make_unshared_geometry(zone.get_geometry());
+			touch_fusion(zone);
+		}
+	}
+
+	void cache_task(zone_geometry_task &task) {
+		for(ZoneFusion *zone_fusion : task.fusions) {
+			typename task_geometry_container_type::const_iterator geometry = task.geometries.find(&zone_fusion->get_fusion());
+			if(geometry != task.geometries.end()) {
+				zone_fusion->get_fusion().set_geometry(geometry->second);
+				cache_fusion(*zone_fusion);
+			}
+		}
+	}
+
+	ZoneFusion *find_zone_fusion(const zone_type &zone) const {
+		typename zone_fusion_index_container_type::const_iterator zone_fusion = zone_fusions.find(&zone);
+		return zone_fusion == zone_fusions.end() ? nullptr : zone_fusion->second;
+	}
+
+	ZoneFusion *find_uncomputed_fusion(ZoneFusion &zone_fusion) const {
+		ZoneFusion *uncomputed_fusion = find_uncomputed_fusion(zone_fusion.get_zone1());
+		return uncomputed_fusion ? uncomputed_fusion : find_uncomputed_fusion(zone_fusion.get_zone2());
+	}
+
+	ZoneFusion *find_uncomputed_fusion(const zone_type &zone) const {
+		return zone.has_geometry() ? nullptr : find_zone_fusion(zone);
+	}
+
+	void push_fusion(ZoneFusion &zone_fusion) {
+		fusion_stack.push_back(&zone_fusion);
+		stacked_fusions.insert(&zone_fusion);
+	}
+
+	void pop_fusion() {
+		stacked_fusions.erase(fusion_stack.back());
+		fusion_stack.pop_back();
+	}
+
+	void join_zones(ZoneFusion &zone_fusion) {
+		geometry_type join_result;
+		// the zones of a fusion are neighbors, otherwise the fusion is joined from its voronoi zones
+		if(join_geometries(zone_fusion.get_zone1().get_geometry(), zone_fusion.get_zone2().get_geometry(), join_result))
+			zone_fusion.get_fusion().set_geometry(join_result);
+		else
+			zone_fusion.get_fusion().compute_geometry();
+		touch_fusion(zone_fusion.get_zone1());
+		touch_fusion(zone_fusion.get_zone2());
+	}
+
+	void touch_fusion(const zone_type &zone) {
+		ZoneFusion *zone_fusion = find_zone_fusion(zone);
+		if(zone_fusion)
+			touch_fusion(*zone_fusion);
+	}
+
+	void touch_fusion(ZoneFusion &zone_fusion) {
+		typename cached_fusion_info_container_type::iterator cached_fusion_info = cached_fusion_infos.find(&zone_fusion);
+		if(cached_fusion_info != cached_fusion_infos.end())
+			cached_fusions.splice(cached_fusions.end(), cached_fusions, cached_fusion_info->second.position);
+	}
+
+	void cache_fusion(ZoneFusion &zone_fusion) {
+		size_t fusion_vertex_size = get_vertex_size(zone_fusion.get_fusion().get_geometry());
+		cached_fusion_infos[&zone_fusion] = { cached_fusions.insert(cached_fusions.end(), &zone_fusion), fusion_vertex_size };
+		vertex_size += fusion_vertex_size;
+	}
+
+	bool is_pinned_fusion(const ZoneFusion &zone_fusion) const {
+		if(pinned_zones.count(&zone_fusion.get_fusion()))
+			return true;
+		typename zone_fusion_index_container_type::const_iterator parent_fusion = parent_fusions.find(&zone_fusion.get_fusion());
+		return parent_fusion != parent_fusions.end() && stacked_fusions.count(parent_fusion->second);
+	}
+
+	void evict_fusions() {
+		cached_fusion_iterator_type cached_fusion = cached_fusions.begin();
+		while(vertex_size > vertex_limit && cached_fusion != boost::prior(cached_fusions.end())) {
+			if(is_pinned_fusion(**cached_fusion))
+				++cached_fusion;
+			else
+				cached_fusion = evict_fusion(cached_fusion);
+		}
+	}
+
+	cached_fusion_iterator_type evict_fusion(cached_fusion_iterator_type cached_fusion) {
+		typename cached_fusion_info_container_type::iterator cached_fusion_info = cached_fusion_infos.find(*cached_fusion);
+		vertex_size -= cached_fusion_info->second.vertex_size;
+		(*cached_fusion)->get_fusion().clear_geometry();
+		cached_fusion_infos.erase(cached_fusion_info);
+		return cached_fusions.erase(cached_fusion);
+	}
+
+	static size_t get_vertex_size(const geometry_type &geometry) {
+		size_t vertex_size = geometry.outer_boundary().size();
+		for(typename geometry_type::Hole_const_iterator hole = geometry.holes_begin(); hole != geometry.holes_end(); ++hole)
+			vertex_size += hole->size();
+		return vertex_size;
+	}
+};
+
+} // namespace geofis
+
+#endif // HC87732CB_3E84_4D55_BD4D_6BF4985884A8
@@ -40,7 +40,7 @@
 #define H376F278A_DCAD_4A78_A550_CD7E2F1D2F24
 
 #include <geofis/algorithm/zoning/fusion/zone_fusion.hpp>
-#include <CGAL/Boolean_set_operations_2.h>
+#include <geofis/geometry/halfedge/halfedge_dissolve.hpp>
 #include <util/address_equal.hpp>
 #include <util/assert.hpp>
 
@@ -98,15 +98,15 @@ private:
 
 	void join_zones(zone_type &zone_result, const zone_type &zone1, const zone_type &zone2) {
 		geometry_type join_result;
-		UTIL_ALLEGE(CGAL::join(zone_fusion.get_zone1().get_geometry(), zone_fusion.get_zone2().get_geometry(), join_result));
+		UTIL_ALLEGE(join_geometries(zone1.get_geometry(), zone2.get_geometry(), join_result));
 		zone_result.set_geometry(join_result);
 	}
 
+	// the difference of a fusion and one of its zones dissolves the common edges of their geometries
 	void difference_zones(zone_type &zone_result, const zone_type &zone1, const zone_type &zone2) {
-		std::vector<geometry_type> difference_results;
-		CGAL::difference(zone1.get_geometry(), zone2.get_geometry(), std::back_inserter(difference_results));
-		UTIL_ASSERT(difference_results.size() == 1);
-		zone_result.set_geometry(difference_results[0]);
+		geometry_type difference_result;
+		UTIL_ALLEGE(difference_geometries(zone1.get_geometry(), zone2.get_geometry(), difference_result));
+		zone_result.set_geometry(difference_result);
 	}
 };
 
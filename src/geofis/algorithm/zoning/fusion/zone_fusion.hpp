@@ -41,7 +41,6 @@
 
 #include <util/address_equal.hpp>
 #include <boost/ref.hpp>
-#include <boost/range/join.hpp>
 #include <geofis/algorithm/zoning/fusion/zone/zone_area_computer.hpp>
 
 namespace geofis {
@@ -53,7 +52,7 @@ title zone_fusion class diagram\n
 
 '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 interface Zone {
-	+ get_voronoi_zones() : voronoi_zone_range_type
+	+ <<constructor>> Zone(zone1: Zone, zone2: Zone)
 }
 
 hide Zone members
@@ -62,12 +61,22 @@ show Zone methods
 '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 class zone_fusion<Zone> {
 	- fusion : Zone
-	+ <<constructor>> zone_fusion(zone_pair: ZonePair)
+	- distance : double
+	- height : double
+	+ <<constructor>> zone_fusion(zone_pair: ZonePair, height: double)
 	+ <<getter>> get_zone1(): Zone
 	+ <<getter>> get_zone2(): Zone
 	+ <<getter>> get_fusion(): Zone
+	+ <<getter>> get_distance(): double
+	+ <<getter>> get_height(): double
 }
 
+note bottom of zone_fusion
+	**distance** is the zone pair distance,
+	**height** is the zone pair distance
+	raised to the heights of the fusions of its zones
+end note
+
 zone_fusion o-- "zone1\nzone2" Zone
 
 @enduml
@@ -80,7 +89,7 @@ template <class Zone> class zone_fusion {
 public:
 	typedef Zone zone_type;
 
-	template <class ZonePair> zone_fusion(ZonePair &zone_pair) : zone1(zone_pair.get_zone1()), zone2(zone_pair.get_zone2()), fusion(boost::range::join(zone_pair.get_zone1().get_voronoi_zones(), zone_pair.get_zone2().get_voronoi_zones())) {
+	template <class ZonePair> zone_fusion(ZonePair &zone_pair, double height) : zone1(zone_pair.get_zone1()), zone2(zone_pair.get_zone2()), fusion(zone_pair.get_zone1(), zone_pair.get_zone2()), distance(zone_pair.get_distance()), height(height) {
 		compute_zone_area(fusion, zone1.get(), zone2.get());
 	}
 
@@ -93,6 +102,9 @@ public:
 	Zone &get_fusion() { return fusion; }
 	const Zone &get_fusion() const { return fusion; }
 
+	double get_distance() const { return distance; }
+	double get_height() const { return height; }
+
 	bool contain_zone(const Zone &zone) const {
 		return util::address_equal(zone, boost::unwrap_ref(zone1)) || util::address_equal(zone, boost::unwrap_ref(zone2));
 	}
@@ -101,6 +113,8 @@ private:
 	zone_reference_type zone1;
 	zone_reference_type zone2;
 	Zone fusion;
+	double distance;
+	double height;
 };
 
 } // namespace geofis
@@ -55,6 +55,7 @@ class associative_zone_distance_computer<Feature> {
 	+ get_distance(): double
 	+ update(other: accumulator_zone_pair_distance)
 	+ update_feature_distances(feature_distances: FeatureDistanceRange)
+	+ update_sampled_feature_distances(feature_distances: FeatureDistanceRange, size: size_t)
 }
 note right: This class aggregate **feature_distances** in **zone_distance** \nbased on **Feature** in boost::accumulators::accumulator_set. \nThe calculation of the **zone_distance** is only valid for associative **Feature**, \nlike boost::accumulators::tag::min or boost::accumulators::tag::max
 
@@ -84,6 +85,11 @@ public:
 		boost::for_each(feature_distances, boost::bind<void>(boost::ref(accumulator), boost::placeholders::_1));
 	}
 
+	//! the extremum of a sample of feature distances approximates the extremum of all the feature distances
+	template <class FeatureDistanceRange> void update_sampled_feature_distances(const FeatureDistanceRange &feature_distances, size_t) {
+		update_feature_distances(feature_distances);
+	}
+
 private:
 	accumulator_type accumulator;
 };
@@ -0,0 +1,115 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H83A9AF56_833F_44EB_8334_3D7D81BA658C
+#define H83A9AF56_833F_44EB_8334_3D7D81BA658C
+
+#include <limits>
+#include <boost/range.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <util/functional/minimum.hpp>
+#include <util/functional/maximum.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/attribute_row_distance.hpp>
+
+namespace geofis {
+
+template <class ZoneDistance> class zone_pair_distance;
+
+/**
+@startuml
+
+title attribute_tree_distance class diagram\n
+
+class attribute_tree_distance<ZonePairDistance> {
+	+ operator()(features: Feature [1..*], attribute_tree: attribute_tree<Feature>, feature_distance: FeatureDistance) : double
+}
+
+note right of attribute_tree_distance
+  extremum of the feature distances between **features** and
+  the features of **attribute_tree**, equal to the zone pair
+  distance of the cross product
+
+  only defined for the minimum and the maximum zone distances
+  with a feature distance that has an attribute_row_distance,
+  see has_attribute_tree_distance
+end note
+
+@enduml
+*/
+
+template <class ZonePairDistance, class FeatureDistance> struct has_attribute_tree_distance : boost::false_type {};
+
+template <class ZonePairDistance> struct attribute_tree_distance;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// specialization of attribute_tree_distance for minimum zone distance
+
+template <class FeatureDistance> struct has_attribute_tree_distance<zone_pair_distance<util::minimum<double> >, FeatureDistance> : has_attribute_row_distance<FeatureDistance> {};
+
+template <> struct attribute_tree_distance<zone_pair_distance<util::minimum<double> > > {
+
+	template <class FeatureRange, class AttributeTree, class FeatureDistance> double operator()(const FeatureRange &features, const AttributeTree &attribute_tree, const FeatureDistance &feature_distance) const {
+		attribute_row_distance<FeatureDistance> row_distance(feature_distance);
+		double minimum = std::numeric_limits<double>::infinity();
+		for(typename boost::range_iterator<const FeatureRange>::type feature = boost::begin(features); feature != boost::end(features); ++feature)
+			attribute_tree.update_minimum_distance(*feature, feature_distance, row_distance, minimum);
+		return minimum;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// specialization of attribute_tree_distance for maximum zone distance
+
+template <class FeatureDistance> struct has_attribute_tree_distance<zone_pair_distance<util::maximum<double> >, FeatureDistance> : has_attribute_row_distance<FeatureDistance> {};
+
+template <> struct attribute_tree_distance<zone_pair_distance<util::maximum<double> > > {
+
+	template <class FeatureRange, class AttributeTree, class FeatureDistance> double operator()(const FeatureRange &features, const AttributeTree &attribute_tree, const FeatureDistance &feature_distance) const {
+		attribute_row_distance<FeatureDistance> row_distance(feature_distance);
+		double maximum = -std::numeric_limits<double>::infinity();
+		for(typename boost::range_iterator<const FeatureRange>::type feature = boost::begin(features); feature != boost::end(features); ++feature)
+			attribute_tree.update_maximum_distance(*feature, feature_distance, row_distance, maximum);
+		return maximum;
+	}
+};
+
+} // namespace geofis
+
+#endif // H83A9AF56_833F_44EB_8334_3D7D81BA658C
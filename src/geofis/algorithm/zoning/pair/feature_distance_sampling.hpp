@@ -0,0 +1,165 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H1FEADBF1_6B20_4C9A_8AE0_65EE41A89DE7
+#define H1FEADBF1_6B20_4C9A_8AE0_65EE41A89DE7
+
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/range.hpp>
+#include <boost/functional/hash.hpp>
+#include <geofis/identifiable/id_comparator.hpp>
+#include <geofis/identifiable/identifiable_comparator.hpp>
+
+namespace geofis {
+
+/**
+@startuml
+
+title feature_distance_sampling class diagram\n
+
+class feature_distance_sampling {
+	- sample_size : size_t
+	- seed : unsigned
+	+ is_exact(size1: size_t, size2: size_t) : bool
+	+ sample_features(zone1: Zone, zone2: Zone, sample1: Feature [0..*], sample2: Feature [0..*]) : void
+}
+
+note right of feature_distance_sampling
+  the feature distances of a zone pair are computed on
+  samples of the zone features when the cross product
+  is larger than **sample_size**, a **sample_size** of 0
+  computes all the feature distances
+
+  the zones are sampled in the order of their ids and
+  the samples only depend on **seed** and the zone and
+  feature ids, so the zone distances do not depend on the
+  thread count nor on the order of the zone features
+end note
+
+@enduml
+*/
+
+class feature_distance_sampling {
+
+public:
+	feature_distance_sampling() : sample_size(0), seed(0) {}
+	feature_distance_sampling(size_t sample_size, unsigned seed) : sample_size(sample_size), seed(seed) {}
+
+	size_t get_sample_size() const {
+		return sample_size;
+	}
+
+	unsigned get_seed() const {
+		return seed;
+	}
+
+	bool is_exact(size_t size1, size_t size2) const {
+		return sample_size == 0 || size1 * size2 <= sample_size;
+	}
+
+	//! sample the features of 2 zones in the order of their ids, the product of the sample sizes is at most **sample_size**
+	template <class Zone, class FeatureSample> void sample_features(const Zone &zone1, const Zone &zone2, FeatureSample &sample1, FeatureSample &sample2) const {
+		if(identifiable_comparator()(zone2, zone1))
+			sample_ordered_features(zone2, zone1, sample1, sample2);
+		else
+			sample_ordered_features(zone1, zone2, sample1, sample2);
+	}
+
+private:
+	size_t sample_size;
+	unsigned seed;
+
+	template <class Zone, class FeatureSample> void sample_ordered_features(const Zone &zone1, const Zone &zone2, FeatureSample &sample1, FeatureSample &sample2) const {
+		std::pair<size_t, size_t> sample_sizes = get_sample_sizes(zone1.size(), zone2.size());
+		size_t zone_seed = make_seed(zone1, zone2);
+		sample(zone1.get_feature_range(), sample_sizes.first, zone_seed, sample1);
+		sample(zone2.get_feature_range(), sample_sizes.second, zone_seed, sample2);
+	}
+
+	// the sample sizes keep the ratio of the zone sizes, **sample_size1** is capped by **sample_size** for very unbalanced zones
+	std::pair<size_t, size_t> get_sample_sizes(size_t size1, size_t size2) const {
+		size_t sample_size1 = std::max<size_t>(1, std::min<size_t>(std::min(size1, sample_size), std::sqrt(double(sample_size) * size1 / size2)));
+		size_t sample_size2 = std::max<size_t>(1, std::min<size_t>(size2, sample_size / sample_size1));
+		return std::make_pair(sample_size1, sample_size2);
+	}
+
+	template <class Zone> size_t make_seed(const Zone &zone1, const Zone &zone2) const {
+		size_t zone_seed = seed;
+		boost::hash_combine(zone_seed, zone1.get_id());
+		boost::hash_combine(zone_seed, zone2.get_id());
+		return zone_seed;
+	}
+
+	template <class FeaturePointer> struct feature_key_less {
+
+		typedef std::pair<size_t, FeaturePointer> feature_key_type;
+
+		bool operator()(const feature_key_type &lhs, const feature_key_type &rhs) const {
+			return lhs.first != rhs.first ? lhs.first < rhs.first : id_comparator()(lhs.second->get_id(), rhs.second->get_id());
+		}
+	};
+
+	// bottom-k sampling, the features of smallest hashed ids are sampled in the order of their hashes,
+	// so the sample does not depend on the order of the zone features, which depends on the fusion order
+	template <class FeatureRange, class FeatureSample> static void sample(const FeatureRange &features, size_t sample_size, size_t zone_seed, FeatureSample &feature_sample) {
+
+		typedef typename boost::range_value<FeatureSample>::type feature_pointer_type;
+		typedef feature_key_less<feature_pointer_type> feature_key_less_type;
+		typedef typename feature_key_less_type::feature_key_type feature_key_type;
+
+		std::vector<feature_key_type> feature_keys;
+		for(typename boost::range_iterator<const FeatureRange>::type feature = boost::begin(features); feature != boost::end(features); ++feature) {
+			size_t feature_key = zone_seed;
+			boost::hash_combine(feature_key, feature->get_id());
+			feature_keys.push_back(feature_key_type(feature_key, &*feature));
+		}
+		sample_size = std::min(sample_size, feature_keys.size());
+		std::nth_element(feature_keys.begin(), feature_keys.begin() + sample_size, feature_keys.end(), feature_key_less_type());
+		std::sort(feature_keys.begin(), feature_keys.begin() + sample_size, feature_key_less_type());
+		feature_sample.reserve(sample_size);
+		for(size_t index = 0; index < sample_size; ++index)
+			feature_sample.push_back(feature_keys[index].second);
+	}
+};
+
+} // namespace geofis
+
+#endif // H1FEADBF1_6B20_4C9A_8AE0_65EE41A89DE7
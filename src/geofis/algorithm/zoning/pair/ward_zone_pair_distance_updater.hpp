@@ -0,0 +1,102 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H99D52CFE_94F9_4D01_A6B4_7595AD1E391F
+#define H99D52CFE_94F9_4D01_A6B4_7595AD1E391F
+
+#include <iterator>
+#include <util/dont_care.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_distance.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_distance_updater.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/ward_zone_distance.hpp>
+
+namespace geofis {
+
+/**
+@startuml
+
+title ward_zone_pair_distance_updater class diagram\n
+
+class ward_zone_pair_distance_updater {
+	+ update_zone_pair_distances(values: std::pair<ZonePairIterator, VariantValue> [0..*]) : void
+}
+
+note right of ward_zone_pair_distance_updater::update_zone_pair_distances
+  the distance of each updated zone pair is computed
+  again on its zones, one of them being the fusion,
+  the normalized means of the fusion are merged from
+  the means of its zones, so the update is in O(attributes)
+
+  the VariantValue (duplicate zone pair or zones
+  to cross) is not needed
+end note
+
+@enduml
+*/
+
+class ward_zone_pair_distance_updater {
+
+public:
+	ward_zone_pair_distance_updater(util::dont_care, size_t, util::dont_care) {}
+
+	template <class UpdatedZonePairRange> void update_zone_pair_distances(const UpdatedZonePairRange &updated_zone_pairs) const {
+
+		typedef typename boost::range_value<UpdatedZonePairRange>::type value_type;
+		typedef typename boost::remove_const<typename value_type::first_type>::type zone_pair_iterator_type;
+		typedef typename std::iterator_traits<zone_pair_iterator_type>::value_type zone_pair_type;
+		typedef typename zone_pair_type::zone_pair_distance_type zone_pair_distance_type;
+
+		for(const value_type &value : updated_zone_pairs) {
+			zone_pair_type &zone_pair = *value.first;
+			zone_pair.set_zone_pair_distance(zone_pair_distance_type(ward_zone_distance(), zone_pair.get_zone1(), zone_pair.get_zone2()));
+		}
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class FeatureDistance> struct zone_pair_distance_updater_traits<ward_zone_distance, FeatureDistance> {
+
+	typedef ward_zone_pair_distance_updater type;
+};
+
+} // namespace geofis
+
+#endif // H99D52CFE_94F9_4D01_A6B4_7595AD1E391F
@@ -45,6 +45,8 @@
 
 namespace geofis {
 
+class ward_zone_pair_distance_updater;
+
 /*
 @startuml
 
@@ -65,6 +67,7 @@ interface ZonePairDistance {
 	+ get_distance() : double
 	+ update(other_zone_pair_distance: ZonePairDistance) : void
 	+ update_feature_distances(feature_distances: FeatureDistanceRange)
+	+ update_sampled_feature_distances(feature_distances: FeatureDistanceRange, size: size_t)
 }
 
 hide ZonePairDistance members
@@ -85,12 +88,14 @@ show zone_pair methods
 zone_pair o-- "zone1\nzone2" Zone
 zone_pair <.right. zone_pair_updater : <<friend>>
 zone_pair <.right. zone_pair_distance_updater : <<friend>>
+zone_pair <.right. ward_zone_pair_distance_updater : <<friend>>
 zone_pair ..> ZonePairDistance : <<call>>
 
 '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
 hide zone_pair_updater members
 hide zone_pair_distance_updater members
+hide ward_zone_pair_distance_updater members
 
 @enduml
 */
@@ -102,10 +107,12 @@ template <class Zone, class ZonePairDistance> class zone_pair {
 
 	template <class FeatureDistance> friend class zone_pair_distance_updater;
 	template <class ZonePairDistanceUpdater> friend class zone_pair_updater;
+	friend class ward_zone_pair_distance_updater;
 
 public:
 	typedef Zone zone_type;
 	typedef typename Zone::id_type id_type;
+	typedef ZonePairDistance zone_pair_distance_type;
 
 	zone_pair(Zone &zone1, Zone &zone2, const ZonePairDistance &zone_pair_distance) : zone1(zone1), zone2(zone2), zone_pair_distance(zone_pair_distance) {}
 
@@ -138,10 +145,18 @@ private:
 		zone_pair_distance.update(other_zone_pair_distance);
 	}
 
+	void set_zone_pair_distance(const ZonePairDistance &zone_pair_distance) {
+		this->zone_pair_distance = zone_pair_distance;
+	}
+
 	template <class FeatureDistanceRange> void update_feature_distances(const FeatureDistanceRange &feature_distances) {
 		zone_pair_distance.update_feature_distances(feature_distances);
 	}
 
+	template <class FeatureDistanceRange> void update_sampled_feature_distances(const FeatureDistanceRange &feature_distances, size_t size) {
+		zone_pair_distance.update_sampled_feature_distances(feature_distances, size);
+	}
+
 	const ZonePairDistance &get_zone_pair_distance() const {
 		return zone_pair_distance;
 	}
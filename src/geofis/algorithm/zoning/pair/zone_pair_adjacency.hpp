@@ -0,0 +1,158 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef ZONE_PAIR_ADJACENCY_HPP_
+#define ZONE_PAIR_ADJACENCY_HPP_
+
+#include <vector>
+#include <iterator>
+#include <unordered_map>
+#include <boost/range/algorithm/find.hpp>
+#include <util/assert.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title zone_pair_adjacency class diagram\n
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+interface ZonePairIterator {
+}
+
+hide ZonePairIterator members
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+interface ZoneFusion {
+	+ get_zone1() : Zone
+	+ get_zone2() : Zone
+	+ get_fusion() : Zone
+}
+
+hide ZoneFusion members
+show ZoneFusion methods
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+class zone_pair_adjacency<ZonePairIterator> {
+	+ add(ZonePairIterator) : void
+	+ erase(ZonePairIterator) : void
+	+ get_zone_pairs(Zone) : std::vector<ZonePairIterator>
+	+ merge(ZoneFusion) : void
+}
+
+show zone_pair_adjacency methods
+
+zone_pair_adjacency o-- "incident zone pairs\nby zone" ZonePairIterator
+zone_pair_adjacency ..> ZoneFusion : <<use>>
+
+note right of zone_pair_adjacency
+	zones are identified by address
+	like in zone_pair::contain_zone
+end note
+
+@enduml
+*/
+
+/**
+ * Index of the zone pairs incident to each zone.
+ *
+ * After a fusion only the zone pairs incident to the two merged zones have to be updated,
+ * so the update cost is proportional to the degree of the merged zones instead of the
+ * number of zone pairs.
+ */
+template <class ZonePairIterator> class zone_pair_adjacency {
+
+	typedef typename std::iterator_traits<ZonePairIterator>::value_type zone_pair_type;
+	typedef typename zone_pair_type::zone_type zone_type;
+
+public:
+	typedef std::vector<ZonePairIterator> zone_pair_iterator_container_type;
+
+private:
+	typedef std::unordered_map<const zone_type *, zone_pair_iterator_container_type> zone_pair_iterator_container_map_type;
+
+public:
+	void add(ZonePairIterator zone_pair) {
+		zone_pairs[&zone_pair->get_zone1()].push_back(zone_pair);
+		zone_pairs[&zone_pair->get_zone2()].push_back(zone_pair);
+	}
+
+	//! must be called before the zone pair is erased from its container
+	void erase(ZonePairIterator zone_pair) {
+		erase(zone_pair->get_zone1(), zone_pair);
+		erase(zone_pair->get_zone2(), zone_pair);
+	}
+
+	const zone_pair_iterator_container_type &get_zone_pairs(const zone_type &zone) const {
+		typename zone_pair_iterator_container_map_type::const_iterator zone_pair_iterators = zone_pairs.find(&zone);
+		UTIL_ASSERT(zone_pair_iterators != zone_pairs.end());
+		return zone_pair_iterators->second;
+	}
+
+	//! the zone pairs incident to the two merged zones become incident to the fusion
+	template <class ZoneFusion> void merge(const ZoneFusion &zone_fusion) {
+		zone_pair_iterator_container_type &fusion_zone_pairs = zone_pairs[&zone_fusion.get_fusion()];
+		move_zone_pairs(zone_fusion.get_zone1(), fusion_zone_pairs);
+		move_zone_pairs(zone_fusion.get_zone2(), fusion_zone_pairs);
+	}
+
+private:
+	zone_pair_iterator_container_map_type zone_pairs;
+
+	void erase(const zone_type &zone, ZonePairIterator zone_pair) {
+		zone_pair_iterator_container_type &zone_pair_iterators = zone_pairs[&zone];
+		typename zone_pair_iterator_container_type::iterator zone_pair_iterator = boost::find(zone_pair_iterators, zone_pair);
+		UTIL_ASSERT(zone_pair_iterator != zone_pair_iterators.end());
+		zone_pair_iterators.erase(zone_pair_iterator);
+	}
+
+	void move_zone_pairs(const zone_type &zone, zone_pair_iterator_container_type &fusion_zone_pairs) {
+		typename zone_pair_iterator_container_map_type::iterator zone_pair_iterators = zone_pairs.find(&zone);
+		UTIL_ASSERT(zone_pair_iterators != zone_pairs.end());
+		fusion_zone_pairs.insert(fusion_zone_pairs.end(), zone_pair_iterators->second.begin(), zone_pair_iterators->second.end());
+		zone_pairs.erase(zone_pair_iterators);
+	}
+};
+
+} // namespace geofis
+
+#endif /* ZONE_PAIR_ADJACENCY_HPP_ */
@@ -39,11 +39,13 @@
 #ifndef ZONE_PAIR_DISTANCE_HPP_
 #define ZONE_PAIR_DISTANCE_HPP_
 
+#include <functional>
 #include <util/dont_care.hpp>
 #include <util/functional/maximum.hpp>
 #include <util/functional/minimum.hpp>
 #include <util/functional/mean.hpp>
 #include <boost/variant.hpp>
+#include <boost/range/numeric.hpp>
 #include <boost/accumulators/statistics/max.hpp>
 #include <boost/accumulators/statistics/sum.hpp>
 #include <boost/accumulators/statistics/count.hpp>
@@ -51,6 +53,8 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/mpl/transform.hpp>
 #include <geofis/algorithm/zoning/pair/accumulator_zone_pair_distance.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_feature_distance.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/ward_zone_distance.hpp>
 
 namespace geofis {
 
@@ -67,25 +71,53 @@ interface zone_pair_distance<ZoneDistance>
 
 class minimum_zone_pair_distance {
 	+ <<constructor>> minimum_zone_pair_distance(feature_distances: FeatureDistanceRange)
+	+ make_partial_distance(feature_distances: FeatureDistanceRange): minimum_zone_pair_distance
 }
 
 class maximum_zone_pair_distance {
 	+ <<constructor>> maximum_zone_pair_distance(feature_distances: FeatureDistanceRange)
+	+ make_partial_distance(feature_distances: FeatureDistanceRange): maximum_zone_pair_distance
 }
 
 class mean_zone_pair_distance {
 	+ <<constructor>> mean_zone_pair_distance(feature_distances: FeatureDistanceRange)
 	+ get_distance(): double
+	+ update_sampled_feature_distances(feature_distances: FeatureDistanceRange, size: size_t)
+	+ make_partial_distance(feature_distances: FeatureDistanceRange): mean_zone_pair_distance
 }
 
+class ward_zone_pair_distance {
+	+ <<constructor>> ward_zone_pair_distance(zone1: Zone, zone2: Zone, feature_distance: FeatureDistance)
+	+ get_distance(): double
+}
+
+note bottom of ward_zone_pair_distance
+	computed on the sizes and the normalized means of the zones only,
+	so the zone pairs are updated by ward_zone_pair_distance_updater
+	without feature distance
+end note
+
 class variant_zone_pair_distance {
 	+ <<constructor>> mean_zone_pair_distance(feature_distances: FeatureDistanceRange)
 	+ get_distance(): double
+	+ make_partial_distance(feature_distances: FeatureDistanceRange): variant_zone_pair_distance
 }
 
+note top of zone_pair_distance
+	each zone_pair_distance can be built from 2 zones and a feature distance,
+	the feature distances of the zone cross product are then computed if needed
+end note
+
+note bottom of variant_zone_pair_distance
+	**make_partial_distance** computes a zone pair distance
+	of the same zone distance on **feature_distances** only,
+	the partial distances are merged with **update**
+end note
+
 zone_pair_distance <|.down. minimum_zone_pair_distance: <<bind>> \n <ZoneDistance -> util::minimum<double>>
 zone_pair_distance <|.down. maximum_zone_pair_distance: <<bind>> \n <ZoneDistance -> util::maximum<double>>
 zone_pair_distance <|.down. mean_zone_pair_distance: <<bind>> \n <ZoneDistance -> util::mean<double>>
+zone_pair_distance <|.down. ward_zone_pair_distance: <<bind>> \n <ZoneDistance -> ward_zone_distance>
 zone_pair_distance <|.down. variant_zone_pair_distance: <<bind>> \n <ZoneDistance -> boost::variant<T...>>
 
 accumulator_zone_pair_distance <|-- minimum_zone_pair_distance: <<bind>> \n <Feature -> boost::accumulators::tag::min>
@@ -107,15 +139,30 @@ template <class ZoneDistance, class FeatureDistanceRange> inline zone_pair_dista
 	return zone_pair_distance<ZoneDistance>(zone_distance, feature_distances);
 }
 
+template <class ZoneDistance, class Zone, class FeatureDistance> inline zone_pair_distance<ZoneDistance> make_zone_pair_distance(const ZoneDistance &zone_distance, const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) {
+	return zone_pair_distance<ZoneDistance>(zone_distance, zone1, zone2, feature_distance);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //! \brief Specialization of zone_pair_distance for minimum zone distance
+/*!
+ * The minimum is taken over all the feature pairs of the 2 zones, not only over the neighbor features.
+ * So the fusion sequence is not a minimum spanning forest of the zone neighbors: once A and B are merged,
+ * the distance to a neighbor C of A can come from a feature pair of B and C, even if B and C were not neighbors.
+ * This is why the distance of an updated zone pair without duplicate needs the feature cross product.
+ */
 template <> class zone_pair_distance<util::minimum<double> > : public accumulator_zone_pair_distance<boost::accumulators::tag::min> {
 
 	typedef accumulator_zone_pair_distance<boost::accumulators::tag::min> base_type;
 
 public:
 	template <class FeatureDistanceRange> zone_pair_distance(util::dont_care, const FeatureDistanceRange &feature_distances) : base_type(feature_distances) {}
+	template <class Zone, class FeatureDistance> zone_pair_distance(util::dont_care, const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) : base_type(make_zone_pair_feature_distance(zone1, zone2, feature_distance)) {}
+
+	template <class FeatureDistanceRange> zone_pair_distance make_partial_distance(const FeatureDistanceRange &feature_distances) const {
+		return zone_pair_distance(util::minimum<double>(), feature_distances);
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,11 +174,21 @@ template <> class zone_pair_distance<util::maximum<double> > : public accumulato
 
 public:
 	template <class FeatureDistanceRange> zone_pair_distance(util::dont_care, const FeatureDistanceRange &feature_distances) : base_type(feature_distances) {}
+	template <class Zone, class FeatureDistance> zone_pair_distance(util::dont_care, const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) : base_type(make_zone_pair_feature_distance(zone1, zone2, feature_distance)) {}
+
+	template <class FeatureDistanceRange> zone_pair_distance make_partial_distance(const FeatureDistanceRange &feature_distances) const {
+		return zone_pair_distance(util::maximum<double>(), feature_distances);
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //! \brief Specialization of zone_pair_distance for mean zone distance
+/*!
+ * The sum and the count of a merged zone pair are combined with update, like a Lance-Williams update.
+ * The feature cross product of an updated zone pair is only computed for 2 zones that have never been neighbors,
+ * neither them nor the zones they come from, so no feature distance is computed twice.
+ */
 template <> class zone_pair_distance<util::mean<double> > {
 
 	typedef boost::accumulators::accumulator_set<double, boost::accumulators::features<boost::accumulators::tag::sum, boost::accumulators::tag::count> > accumulator_type;
@@ -141,6 +198,10 @@ public:
 		update_feature_distances(feature_distances);
 	}
 
+	template <class Zone, class FeatureDistance> zone_pair_distance(util::dont_care, const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) : sum(0.), count(0) {
+		update_feature_distances(make_zone_pair_feature_distance(zone1, zone2, feature_distance));
+	}
+
 	double get_distance() const {
 #ifdef __MINGW32__
 		// convert std::size_t to int otherwise ununderstandable warning "maybe-uninitialized"
@@ -159,6 +220,18 @@ public:
 		boost::for_each(feature_distances, boost::bind<void>(boost::ref(accumulator), boost::placeholders::_1));
 	}
 
+	//! the sample mean of **feature_distances** is counted for **size** feature distances
+	template <class FeatureDistanceRange> void update_sampled_feature_distances(const FeatureDistanceRange &feature_distances, std::size_t size) {
+		accumulator_type sample_accumulator;
+		boost::for_each(feature_distances, boost::bind<void>(boost::ref(sample_accumulator), boost::placeholders::_1));
+		sum += boost::accumulators::sum(sample_accumulator) * size / boost::accumulators::count(sample_accumulator);
+		count += size;
+	}
+
+	template <class FeatureDistanceRange> zone_pair_distance make_partial_distance(const FeatureDistanceRange &feature_distances) const {
+		return zone_pair_distance(util::mean<double>(), feature_distances);
+	}
+
 private:
 	accumulator_type accumulator;
 	double sum;
@@ -175,6 +248,41 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//! \brief Specialization of zone_pair_distance for Ward zone distance
+/*!
+ * The distance is the increase of the sum of squares of the normalized attributes when the 2 zones are merged.
+ * It only depends on the zone sizes and normalized means, so no feature distance is computed
+ * and the distance of an updated zone pair is computed in O(attributes) whatever the zone sizes.
+ */
+template <> class zone_pair_distance<ward_zone_distance> {
+
+public:
+	template <class Zone> zone_pair_distance(util::dont_care, const Zone &zone1, const Zone &zone2) : distance(compute_distance(zone1, zone2)) {}
+	template <class Zone> zone_pair_distance(util::dont_care, const Zone &zone1, const Zone &zone2, util::dont_care) : distance(compute_distance(zone1, zone2)) {}
+
+	double get_distance() const {
+		return distance;
+	}
+
+private:
+	double distance;
+
+	struct square_difference {
+
+		double operator()(double lhs, double rhs) const {
+			return (lhs - rhs) * (lhs - rhs);
+		}
+	};
+
+	template <class Zone> static double compute_distance(const Zone &zone1, const Zone &zone2) {
+		double size1 = zone1.size();
+		double size2 = zone2.size();
+		return size1 * size2 / (size1 + size2) * boost::inner_product(zone1.get_normalized_means(), zone2.get_normalized_means(), 0., std::plus<double>(), square_difference());
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 //! \brief Specialization of zone_pair_distance for variant zone distance
 template <class... Types> class zone_pair_distance<boost::variant<Types...> > {
 
@@ -185,6 +293,7 @@ template <class... Types> class zone_pair_distance<boost::variant<Types...> > {
 
 public:
 	template <class FeatureDistanceRange> zone_pair_distance(const zone_distance_type &zone_distance, const FeatureDistanceRange &feature_distances) : variant_zone_pair_distance(boost::apply_visitor(make_variant_zone_pair_distance_initializer(feature_distances), zone_distance)) {}
+	template <class Zone, class FeatureDistance> zone_pair_distance(const zone_distance_type &zone_distance, const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) : variant_zone_pair_distance(boost::apply_visitor(zone_variant_zone_pair_distance_initializer<Zone, FeatureDistance>(zone1, zone2, feature_distance), zone_distance)) {}
 
 	double get_distance() const {
 		return boost::apply_visitor(distance_getter(), variant_zone_pair_distance);
@@ -198,9 +307,19 @@ public:
 		boost::apply_visitor(make_feature_distances_updater(feature_distances), variant_zone_pair_distance);
 	}
 
+	template <class FeatureDistanceRange> void update_sampled_feature_distances(const FeatureDistanceRange &feature_distances, std::size_t size) {
+		boost::apply_visitor(sampled_feature_distances_updater<FeatureDistanceRange>(feature_distances, size), variant_zone_pair_distance);
+	}
+
+	template <class FeatureDistanceRange> zone_pair_distance make_partial_distance(const FeatureDistanceRange &feature_distances) const {
+		return zone_pair_distance(boost::apply_visitor(make_partial_distance_maker(feature_distances), variant_zone_pair_distance));
+	}
+
 private:
 	variant_zone_pair_distance_type variant_zone_pair_distance;
 
+	zone_pair_distance(const variant_zone_pair_distance_type &variant_zone_pair_distance) : variant_zone_pair_distance(variant_zone_pair_distance) {}
+
 	template <class FeatureDistanceRange> struct variant_zone_pair_distance_initializer : public boost::static_visitor<variant_zone_pair_distance_type> {
 
 		variant_zone_pair_distance_initializer(const FeatureDistanceRange &feature_distances) : feature_distances(feature_distances) {}
@@ -216,6 +335,19 @@ private:
 		return variant_zone_pair_distance_initializer<FeatureDistanceRange>(feature_distances);
 	}
 
+	template <class Zone, class FeatureDistance> struct zone_variant_zone_pair_distance_initializer : public boost::static_visitor<variant_zone_pair_distance_type> {
+
+		zone_variant_zone_pair_distance_initializer(const Zone &zone1, const Zone &zone2, const FeatureDistance &feature_distance) : zone1(zone1), zone2(zone2), feature_distance(feature_distance) {}
+
+	    template <class ZoneDistance> variant_zone_pair_distance_type operator()(const ZoneDistance &zone_distance) const {
+	    	return variant_zone_pair_distance_type(make_zone_pair_distance(zone_distance, zone1, zone2, feature_distance));
+	    }
+
+	    const Zone &zone1;
+	    const Zone &zone2;
+	    const FeatureDistance &feature_distance;
+	};
+
 	struct distance_getter : public boost::static_visitor<double> {
 
 		template <class ZonePairDistance> double operator()(const ZonePairDistance &zone_pair_distance) const {
@@ -247,6 +379,33 @@ private:
 	template <class FeatureDistanceRange> static inline feature_distances_updater<FeatureDistanceRange> make_feature_distances_updater(const FeatureDistanceRange &feature_distances) {
 		return feature_distances_updater<FeatureDistanceRange>(feature_distances);
 	}
+
+	template <class FeatureDistanceRange> struct sampled_feature_distances_updater : public boost::static_visitor<> {
+
+		sampled_feature_distances_updater(const FeatureDistanceRange &feature_distances, std::size_t size) : feature_distances(feature_distances), size(size) {}
+
+	    template <class ZonePairDistance> void operator()(ZonePairDistance &zone_pair_distance) const {
+	    	zone_pair_distance.update_sampled_feature_distances(feature_distances, size);
+	    }
+
+	    const FeatureDistanceRange &feature_distances;
+	    std::size_t size;
+	};
+
+	template <class FeatureDistanceRange> struct partial_distance_maker : public boost::static_visitor<variant_zone_pair_distance_type> {
+
+		partial_distance_maker(const FeatureDistanceRange &feature_distances) : feature_distances(feature_distances) {}
+
+	    template <class ZonePairDistance> variant_zone_pair_distance_type operator()(const ZonePairDistance &zone_pair_distance) const {
+	    	return variant_zone_pair_distance_type(zone_pair_distance.make_partial_distance(feature_distances));
+	    }
+
+	    const FeatureDistanceRange &feature_distances;
+	};
+
+	template <class FeatureDistanceRange> static inline partial_distance_maker<FeatureDistanceRange> make_partial_distance_maker(const FeatureDistanceRange &feature_distances) {
+		return partial_distance_maker<FeatureDistanceRange>(feature_distances);
+	}
 };
 
 } // namespace geofis
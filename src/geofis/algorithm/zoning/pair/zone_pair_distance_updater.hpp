@@ -39,9 +39,21 @@
 #ifndef H74C3F1C1_0BB9_4DE7_A1FE_693F42F7D120
 #define H74C3F1C1_0BB9_4DE7_A1FE_693F42F7D120
 
+#include <vector>
 #include <utility>
+#include <iterator>
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/variant.hpp>
+#include <boost/optional.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/range/adaptor/indirected.hpp>
+#include <util/assert.hpp>
+#include <util/range/transform_all_range.hpp>
+#include <util/algorithm/parallel_for_each_chunk.hpp>
+#include <util/functional/binary_reference_adaptor.hpp>
+#include <geofis/algorithm/zoning/pair/feature_distance_sampling.hpp>
+#include <geofis/algorithm/zoning/pair/attribute_tree_distance.hpp>
 
 namespace geofis {
 
@@ -50,17 +62,20 @@ namespace geofis {
 
 title zone_pair_distance_updater class diagram\n
 
-'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
 interface FeatureDistance {
 }
 
 hide FeatureDistance members
 
-'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
 class zone_pair_distance_updater<FeatureDistance> {
+	- thread_count : size_t
+	- sampling : feature_distance_sampling
 	+ operator()(value: std::pair<ZonePairIterator, VariantValue>) : void
+	+ update_zone_pair_distances(values: std::pair<ZonePairIterator, VariantValue> [0..*]) : void
 }
 
 hide zone_pair_distance_updater members
@@ -73,20 +88,82 @@ note right of zone_pair_distance_updater::operator()
   see update_zone_pairs documentation
 end note
 
+note right of zone_pair_distance_updater::update_zone_pair_distances
+  the feature distance cross products are split in
+  **feature_distance_blocks** computed on **thread_count** threads,
+  a cross product larger than **feature_distance_block_size**
+  is split in blocks of the larger zone features, each block
+  computes a partial zone pair distance merged in block order
+
+  the blocks only depend on the zone sizes, so
+  the zone pair distances do not depend on **thread_count**,
+  even on a single thread the mean distance of a split cross
+  product is summed block by block, so it can differ in the
+  last bits from a sum over the whole cross product
+
+  a cross product larger than the **sampling** size is
+  computed in one block on samples of the zone features
+
+  when the zone pair distance has an attribute_tree_distance,
+  a zone pair whose larger zone has at least **attribute_tree_size**
+  features is computed exactly with the attribute tree of the
+  larger zone, queried with blocks of **attribute_tree_block_size**
+  features of the other zone, before any sampling
+end note
+
 @enduml
 */
 
+template <class FeatureDistance> class zone_pair_distance_updater;
+
+//! zone pair distance updater of the fusion process for a zone distance, specialized when the feature distances are not used
+template <class ZoneDistance, class FeatureDistance> struct zone_pair_distance_updater_traits {
+
+	typedef zone_pair_distance_updater<FeatureDistance> type;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <class FeatureDistance> class zone_pair_distance_updater {
 
 public:
-	zone_pair_distance_updater(const FeatureDistance &feature_distance) : feature_distance(feature_distance) {}
+	//! maximum number of feature distances computed in one block of a zone pair cross product
+	static const size_t feature_distance_block_size = 1 << 14;
+	//! minimum number of feature distances to update the zone pair distances on several threads
+	static const size_t parallel_feature_distance_size = 1 << 16;
+	//! minimum number of features of the larger zone to compute the zone pair distance with its attribute tree
+	static const size_t attribute_tree_size = 1 << 7;
+	//! maximum number of features of the other zone queried in one block of the attribute tree
+	static const size_t attribute_tree_block_size = 1 << 10;
+
+	zone_pair_distance_updater(const FeatureDistance &feature_distance, size_t thread_count = 1, const feature_distance_sampling &sampling = feature_distance_sampling()) : feature_distance(feature_distance), thread_count(thread_count), sampling(sampling) {}
 
 	template <class ZonePairIterator, class VariantValue> void operator()(const std::pair<ZonePairIterator, VariantValue> &value) const {
 		update_zone_pair_distance(*value.first, value.second);
 	}
 
+	template <class UpdatedZonePairRange> void update_zone_pair_distances(const UpdatedZonePairRange &updated_zone_pairs) const {
+
+		typedef typename boost::range_value<UpdatedZonePairRange>::type value_type;
+		typedef typename boost::remove_const<typename value_type::first_type>::type zone_pair_iterator_type;
+		typedef typename std::iterator_traits<zone_pair_iterator_type>::value_type zone_pair_type;
+		typedef feature_distance_block<zone_pair_type> feature_distance_block_type;
+		typedef std::vector<feature_distance_block_type> feature_distance_block_container_type;
+
+		feature_distance_block_container_type feature_distance_blocks;
+		size_t feature_distance_size = 0;
+		for(const value_type &value : updated_zone_pairs)
+			feature_distance_size += boost::apply_visitor(feature_distance_block_maker<zone_pair_type>(feature_distance, sampling, *value.first, feature_distance_blocks), value.second);
+		size_t block_thread_count = feature_distance_size < parallel_feature_distance_size ? 1 : thread_count;
+		util::parallel_for_each_chunk(feature_distance_blocks.size(), block_thread_count, feature_distance_block_computer<zone_pair_type>(feature_distance, feature_distance_blocks));
+		for(feature_distance_block_type &feature_distance_block : feature_distance_blocks)
+			feature_distance_block.merge_partial_distance();
+	}
+
 private:
 	const FeatureDistance &feature_distance;
+	size_t thread_count;
+	feature_distance_sampling sampling;
 
 	template <class ZonePair> struct value_visitor : public boost::static_visitor<void> {
 
@@ -115,6 +192,159 @@ private:
 	template <class ZonePair, class VariantValue> void update_zone_pair_distance(ZonePair &zone_pair, const VariantValue &value) const {
 		boost::apply_visitor(value_visitor<ZonePair>(feature_distance, zone_pair), value);
 	}
+
+	//! part of the feature distance cross product of a zone pair, **partial** when the cross product is split in several blocks, **sampled** when computed on samples of the zone features, computed with the **attribute_tree** of a zone when not null
+	template <class ZonePair> struct feature_distance_block {
+
+		typedef typename ZonePair::zone_type zone_type;
+		typedef typename ZonePair::zone_pair_distance_type zone_pair_distance_type;
+		typedef typename zone_type::feature_type feature_type;
+		typedef typename zone_type::attribute_tree_type attribute_tree_type;
+		typedef typename zone_type::feature_range_type feature_range_type;
+		typedef boost::iterator_range<typename boost::range_iterator<const feature_range_type>::type> feature_block_range_type;
+		typedef std::vector<const feature_type *> feature_sample_type;
+
+		feature_distance_block(ZonePair &zone_pair, const feature_block_range_type &features1, const feature_block_range_type &features2, bool partial) : zone_pair(&zone_pair), features1(features1), features2(features2), partial(partial), sampled_size(0), attribute_tree(nullptr) {}
+		feature_distance_block(ZonePair &zone_pair, size_t sampled_size) : zone_pair(&zone_pair), partial(false), sampled_size(sampled_size), attribute_tree(nullptr) {}
+		feature_distance_block(ZonePair &zone_pair, const feature_block_range_type &features1, const attribute_tree_type &attribute_tree, bool partial) : zone_pair(&zone_pair), features1(features1), partial(partial), sampled_size(0), attribute_tree(&attribute_tree) {}
+
+		void compute(const FeatureDistance &feature_distance) {
+			util::binary_reference_adaptor<const FeatureDistance> distance(feature_distance);
+			if(attribute_tree)
+				compute_attribute_tree_distance(feature_distance, typename has_attribute_tree_distance<zone_pair_distance_type, FeatureDistance>::type());
+			else if(sampled_size > 0)
+				zone_pair->update_sampled_feature_distances(util::make_transform_all(feature_sample1 | boost::adaptors::indirected, feature_sample2 | boost::adaptors::indirected, distance), sampled_size);
+			else
+				update_feature_distances(util::make_transform_all(features1, features2, distance));
+		}
+
+		// the extremum of the feature distances between **features1** and the **attribute_tree** features
+		void compute_attribute_tree_distance(const FeatureDistance &feature_distance, boost::true_type) {
+			double distance = attribute_tree_distance<zone_pair_distance_type>()(features1, *attribute_tree, feature_distance);
+			update_feature_distances(boost::make_iterator_range(&distance, &distance + 1));
+		}
+
+		void compute_attribute_tree_distance(const FeatureDistance &, boost::false_type) {
+			UTIL_ASSERT(false);
+		}
+
+		template <class FeatureDistanceRange> void update_feature_distances(const FeatureDistanceRange &feature_distances) {
+			if(partial)
+				partial_distance = zone_pair->get_zone_pair_distance().make_partial_distance(feature_distances);
+			else
+				zone_pair->update_feature_distances(feature_distances);
+		}
+
+		void merge_partial_distance() {
+			if(partial_distance)
+				zone_pair->update_zone_pair_distance(partial_distance.get());
+		}
+
+		ZonePair *zone_pair;
+		feature_block_range_type features1;
+		feature_block_range_type features2;
+		bool partial;
+		boost::optional<zone_pair_distance_type> partial_distance;
+		//! size of the sampled cross product, 0 if not sampled
+		size_t sampled_size;
+		feature_sample_type feature_sample1;
+		feature_sample_type feature_sample2;
+		const attribute_tree_type *attribute_tree;
+	};
+
+	// update the zone pair with a duplicate immediately, or split its cross product in **feature_distance_blocks**, return the number of feature distances to compute
+	template <class ZonePair> struct feature_distance_block_maker : public boost::static_visitor<size_t> {
+
+		typedef feature_distance_block<ZonePair> feature_distance_block_type;
+		typedef typename feature_distance_block_type::feature_block_range_type feature_block_range_type;
+		typedef typename feature_distance_block_type::attribute_tree_type attribute_tree_type;
+		typedef typename feature_distance_block_type::zone_pair_distance_type zone_pair_distance_type;
+		typedef typename boost::range_iterator<feature_block_range_type>::type feature_iterator_type;
+
+		feature_distance_block_maker(const FeatureDistance& feature_distance, const feature_distance_sampling &sampling, ZonePair &zone_pair, std::vector<feature_distance_block_type> &feature_distance_blocks) : feature_distance(feature_distance), sampling(sampling), zone_pair(zone_pair), feature_distance_blocks(feature_distance_blocks) {}
+
+		template <class ZonePairIterator> result_type operator()(const ZonePairIterator &zone_pair_iterator) const {
+			value_visitor<ZonePair>(feature_distance, zone_pair).update_zone_pair_distance_with_duplicate(*zone_pair_iterator);
+			return 0;
+		}
+
+		template <class ZoneReference> result_type operator()(const std::pair<ZoneReference, ZoneReference> &zones) const {
+			feature_block_range_type features1 = boost::make_iterator_range(boost::unwrap_ref(zones.first).get_feature_range());
+			feature_block_range_type features2 = boost::make_iterator_range(boost::unwrap_ref(zones.second).get_feature_range());
+			size_t size1 = boost::unwrap_ref(zones.first).size();
+			size_t size2 = boost::unwrap_ref(zones.second).size();
+			if(has_attribute_tree_distance<zone_pair_distance_type, FeatureDistance>::value && std::max(size1, size2) >= attribute_tree_size) {
+				if(size1 >= size2)
+					return add_attribute_tree_blocks(boost::unwrap_ref(zones.first), features2, size2);
+				return add_attribute_tree_blocks(boost::unwrap_ref(zones.second), features1, size1);
+			}
+			if(!sampling.is_exact(size1, size2))
+				return add_sampled_feature_distance_block(boost::unwrap_ref(zones.first), boost::unwrap_ref(zones.second), size1 * size2);
+			size_t block_count = (size1 * size2 + feature_distance_block_size - 1) / feature_distance_block_size;
+			if(block_count <= 1)
+				feature_distance_blocks.push_back(feature_distance_block_type(zone_pair, features1, features2, false));
+			else if(size1 >= size2)
+				add_feature_distance_blocks(features1, size1, block_count, features2, true);
+			else
+				add_feature_distance_blocks(features2, size2, block_count, features1, false);
+			return size1 * size2;
+		}
+
+		// split **features** in **block_count** blocks, each block is crossed with **other_features**
+		void add_feature_distance_blocks(const feature_block_range_type &features, size_t size, size_t block_count, const feature_block_range_type &other_features, bool first) const {
+			block_count = std::min(block_count, size);
+			feature_iterator_type block_end = boost::begin(features);
+			for(size_t block = 0; block < block_count; ++block) {
+				feature_iterator_type block_begin = block_end;
+				std::advance(block_end, util::get_chunk_begin(block + 1, size, block_count) - util::get_chunk_begin(block, size, block_count));
+				feature_block_range_type block_features(block_begin, block_end);
+				if(first)
+					feature_distance_blocks.push_back(feature_distance_block_type(zone_pair, block_features, other_features, true));
+				else
+					feature_distance_blocks.push_back(feature_distance_block_type(zone_pair, other_features, block_features, true));
+			}
+		}
+
+		// split **features** in blocks of at most **attribute_tree_block_size** features, each block queries the attribute tree of **zone**
+		template <class Zone> size_t add_attribute_tree_blocks(const Zone &zone, const feature_block_range_type &features, size_t size) const {
+			const attribute_tree_type &attribute_tree = zone.get_attribute_tree();
+			size_t block_count = (size + attribute_tree_block_size - 1) / attribute_tree_block_size;
+			feature_iterator_type block_end = boost::begin(features);
+			for(size_t block = 0; block < block_count; ++block) {
+				feature_iterator_type block_begin = block_end;
+				std::advance(block_end, util::get_chunk_begin(block + 1, size, block_count) - util::get_chunk_begin(block, size, block_count));
+				feature_distance_blocks.push_back(feature_distance_block_type(zone_pair, feature_block_range_type(block_begin, block_end), attribute_tree, block_count > 1));
+			}
+			return size * attribute_tree_type::leaf_size;
+		}
+
+		template <class Zone> size_t add_sampled_feature_distance_block(const Zone &zone1, const Zone &zone2, size_t size) const {
+			feature_distance_blocks.push_back(feature_distance_block_type(zone_pair, size));
+			feature_distance_block_type &feature_distance_block = feature_distance_blocks.back();
+			sampling.sample_features(zone1, zone2, feature_distance_block.feature_sample1, feature_distance_block.feature_sample2);
+			return feature_distance_block.feature_sample1.size() * feature_distance_block.feature_sample2.size();
+		}
+
+		const FeatureDistance &feature_distance;
+		const feature_distance_sampling &sampling;
+		ZonePair &zone_pair;
+		std::vector<feature_distance_block_type> &feature_distance_blocks;
+	};
+
+	template <class ZonePair> struct feature_distance_block_computer {
+
+		typedef feature_distance_block<ZonePair> feature_distance_block_type;
+
+		feature_distance_block_computer(const FeatureDistance& feature_distance, std::vector<feature_distance_block_type> &feature_distance_blocks) : feature_distance(feature_distance), feature_distance_blocks(feature_distance_blocks) {}
+
+		void operator()(size_t, size_t begin, size_t end) const {
+			for(size_t block = begin; block < end; ++block)
+				feature_distance_blocks[block].compute(feature_distance);
+		}
+
+		const FeatureDistance &feature_distance;
+		std::vector<feature_distance_block_type> &feature_distance_blocks;
+	};
 };
 
 } // namespace geofis
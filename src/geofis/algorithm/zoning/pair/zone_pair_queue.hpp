@@ -0,0 +1,206 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef ZONE_PAIR_QUEUE_HPP_
+#define ZONE_PAIR_QUEUE_HPP_
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <unordered_map>
+#include <boost/heap/d_ary_heap.hpp>
+#include <util/assert.hpp>
+#include <util/double.h>
+
+namespace geofis {
+
+/*
+@startuml
+
+title zone_pair_queue class diagram\n
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+interface ZonePairIterator {
+}
+
+hide ZonePairIterator members
+
+'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+
+class zone_pair_queue<ZonePairIterator> {
+	- step : size_t
+	+ push(ZonePairIterator) : void
+	+ top() : ZonePairIterator
+	+ pop(ZonePairIterator) : void
+	+ update(ZonePairIterator) : void
+	+ erase(ZonePairIterator) : void
+	+ precedes(ZonePairIterator, ZonePairIterator) : bool
+	+ copy(OutputIterator) : OutputIterator
+}
+
+show zone_pair_queue methods
+
+zone_pair_queue o-- "heap" ZonePairIterator
+
+note right of zone_pair_queue
+	addressable min heap (boost::heap::d_ary_heap)
+	each node keep the distance history of its **zone_pair**
+end note
+
+@enduml
+*/
+
+/**
+ * Addressable min heap of zone pairs in merging order.
+ *
+ * The merging order is the one given by successive stable sorts of the zone pairs list
+ * (see minimum_aggregation): at step k, lhs precedes rhs if its distance is less
+ * or, in case of equality, if lhs preceded rhs at step k - 1. At the first step
+ * the ties are broken with the push order, i.e. the zone_pair_id_comparator order.
+ * Each node keeps the (step, distance) history of its zone pair to reproduce it.
+ */
+template <class ZonePairIterator> class zone_pair_queue {
+
+	typedef typename std::iterator_traits<ZonePairIterator>::value_type zone_pair_type;
+	typedef std::pair<size_t, double> step_distance_type;
+	typedef std::vector<step_distance_type> step_distance_container_type;
+	typedef typename step_distance_container_type::const_reverse_iterator step_distance_iterator_type;
+
+	struct zone_pair_node {
+
+		zone_pair_node(ZonePairIterator zone_pair, size_t rank, size_t step) : zone_pair(zone_pair), rank(rank), distances(1, step_distance_type(step, zone_pair->get_distance())) {}
+
+		ZonePairIterator zone_pair;
+		size_t rank;
+		step_distance_container_type distances;
+	};
+
+	static bool precedes(const zone_pair_node &lhs, const zone_pair_node &rhs) {
+		step_distance_iterator_type lhs_distance = lhs.distances.rbegin();
+		step_distance_iterator_type rhs_distance = rhs.distances.rbegin();
+		while(true) {
+			if(UTIL_DOUBLE_LESS(lhs_distance->second, rhs_distance->second))
+				return true;
+			if(UTIL_DOUBLE_LESS(rhs_distance->second, lhs_distance->second))
+				return false;
+			size_t lhs_step = lhs_distance->first;
+			size_t rhs_step = rhs_distance->first;
+			if(lhs_step == 0 && rhs_step == 0)
+				return lhs.rank < rhs.rank;
+			if(lhs_step >= rhs_step)
+				++lhs_distance;
+			if(rhs_step >= lhs_step)
+				++rhs_distance;
+		}
+	}
+
+	struct zone_pair_node_greater {
+
+		bool operator()(const zone_pair_node &lhs, const zone_pair_node &rhs) const {
+			return precedes(rhs, lhs);
+		}
+	};
+
+	typedef boost::heap::d_ary_heap<zone_pair_node, boost::heap::arity<4>, boost::heap::mutable_<true>, boost::heap::compare<zone_pair_node_greater> > heap_type;
+	typedef typename heap_type::handle_type handle_type;
+	typedef std::unordered_map<const zone_pair_type *, handle_type> handle_container_type;
+
+public:
+	zone_pair_queue() : step(0), rank(0) {}
+
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+
+	//! must be called in zone_pair_id_comparator order before the first pop
+	void push(ZonePairIterator zone_pair) {
+		UTIL_ASSERT(step == 0);
+		handles.insert(std::make_pair(&*zone_pair, heap.push(zone_pair_node(zone_pair, rank++, step))));
+	}
+
+	ZonePairIterator top() const {
+		return heap.top().zone_pair;
+	}
+
+	//! remove the merged zone pair and start the next fusion step
+	void pop(ZonePairIterator zone_pair) {
+		erase(zone_pair);
+		++step;
+	}
+
+	//! must be called after each distance update of a zone pair in the queue
+	void update(ZonePairIterator zone_pair) {
+		handle_type handle = get_handle(zone_pair);
+		(*handle).distances.push_back(step_distance_type(step, zone_pair->get_distance()));
+		heap.update(handle);
+	}
+
+	void erase(ZonePairIterator zone_pair) {
+		typename handle_container_type::iterator handle = handles.find(&*zone_pair);
+		UTIL_ASSERT(handle != handles.end());
+		heap.erase(handle->second);
+		handles.erase(handle);
+	}
+
+	bool precedes(ZonePairIterator lhs, ZonePairIterator rhs) const {
+		return precedes(*get_handle(lhs), *get_handle(rhs));
+	}
+
+	//! copy the zone pairs to **output**, in heap storage order
+	template <class OutputIterator> OutputIterator copy(OutputIterator output) const {
+		for(const zone_pair_node &node : heap)
+			*output++ = node.zone_pair;
+		return output;
+	}
+
+private:
+	heap_type heap;
+	handle_container_type handles;
+	size_t step;
+	size_t rank;
+
+	handle_type get_handle(ZonePairIterator zone_pair) const {
+		typename handle_container_type::const_iterator handle = handles.find(&*zone_pair);
+		UTIL_ASSERT(handle != handles.end());
+		return handle->second;
+	}
+};
+
+} // namespace geofis
+
+#endif /* ZONE_PAIR_QUEUE_HPP_ */
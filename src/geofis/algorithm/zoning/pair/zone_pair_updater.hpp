@@ -47,6 +47,8 @@
 #include <boost/ref.hpp>
 #include <boost/variant.hpp>
 #include <boost/optional.hpp>
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/join.hpp>
 #include <boost/range/algorithm/for_each.hpp>
 //#include <geofis/algorithm/zoning/zone_pair_equal.hpp>
 #include <geofis/algorithm/zoning/pair/zone_pair_distance_updater.hpp>
@@ -90,7 +92,7 @@ ZonePair ..> updated_zone_type : <<use>>
 '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
 interface ZonePairDistanceUpdater {
-	+ operator()(updated_zone_pair_iterator_type): void
+	+ update_zone_pair_distances(updated_zone_pair_iterator_type [0..*]): void
 }
 
 hide ZonePairDistanceUpdater members
@@ -102,7 +104,7 @@ ZonePairDistanceUpdater ..> updated_zone_pair_iterator_type : <<use>>
 
 class zone_pair_updater<ZonePairDistanceUpdater> {
 	- zone_pair_distance_updater : ZonePairDistanceUpdater
-	+ update_zone_pairs(std::list<ZonePair>, ZoneFusion, std::list<ZonePairIterator>) : void
+	+ update_zone_pairs(std::list<ZonePair>, ZoneFusion, ZonePairQueue, ZonePairAdjacency) : void
 }
 
 zone_pair_updater ..> ZonePair : <<call>>
@@ -121,13 +123,17 @@ public:
 
 	start
 
-	:update all **zone_pairs** according to **zone_fusion**
+	:update **zone_pairs** incident to the merged zones according to **zone_fusion**
 	copy duplicate **zone_pairs** in **duplicate_zone_pairs**;
 	note left
-	 	 **zone_pairs** must be ordered in merging order
+	 	 incident **zone_pairs** are given by **zone_pair_adjacency**
+	 	 the duplicate is the **zone_pair** coming last
+	 	 in **zone_pair_queue** merging order
 	end note
 
-	:remove **duplicate_zone_pairs** from **zone_pairs_to_merge**;
+	:merge incident **zone_pairs** of the merged zones in **zone_pair_adjacency**;
+	:remove **duplicate_zone_pairs** from **zone_pair_queue**;
+	:remove **duplicate_zone_pairs** from **zone_pair_adjacency**;
 	:remove **duplicate_zone_pairs** from **zone_pairs**;
 
 	end
@@ -135,14 +141,14 @@ public:
 	@enduml
 	*/
 
-	template <class ZonePair, class ZoneFusion, class ZonePairIterator> void update_zone_pairs(std::list<ZonePair> &zone_pairs, ZoneFusion &zone_fusion, std::list<ZonePairIterator> &zone_pairs_to_merge) const {
+	template <class ZonePair, class ZoneFusion, class ZonePairQueue, class ZonePairAdjacency> void update_zone_pairs(std::list<ZonePair> &zone_pairs, ZoneFusion &zone_fusion, ZonePairQueue &zone_pair_queue, ZonePairAdjacency &zone_pair_adjacency) const {
 
 		typedef typename std::list<ZonePair>::iterator zone_pair_iterator_type;
 
 		std::vector<zone_pair_iterator_type> duplicate_zone_pairs;
-		update_zone_pairs(boost::begin(zone_pairs), boost::end(zone_pairs), zone_fusion, std::back_inserter(duplicate_zone_pairs));
-		remove_zone_pairs_to_merge(zone_pairs_to_merge, duplicate_zone_pairs);
-		remove_zone_pairs(zone_pairs, duplicate_zone_pairs);
+		update_zone_pairs(boost::range::join(zone_pair_adjacency.get_zone_pairs(zone_fusion.get_zone1()), zone_pair_adjacency.get_zone_pairs(zone_fusion.get_zone2())), zone_fusion, zone_pair_queue, std::back_inserter(duplicate_zone_pairs));
+		zone_pair_adjacency.merge(zone_fusion);
+		remove_zone_pairs(zone_pairs, zone_pair_queue, zone_pair_adjacency, duplicate_zone_pairs);
 	}
 
 private:
@@ -172,7 +178,7 @@ private:
 
 	floating note left: In this diagram **zone_pair** is an iterator type.
 
-	while (for each **zone_pair** in **zone_pairs**)
+	while (for each **zone_pair** incident to the merged zones)
 		:update zones of **zone_pair** according to **zone_fusion**;
 		note left
 			zone updating replace zone in **zone_pair** with **zone_fusion**
@@ -196,7 +202,8 @@ private:
 			end note
 
 			if (**zone_pair** already present in **updated_zone_pairs** ?) then (yes)
-				:copy **zone_pair** in **duplicate_zone_pairs**;
+				:keep the first **zone_pair** in merging order in **updated_zone_pairs**
+				copy the other in **duplicate_zone_pairs**;
 			else (no)
 			endif
 		else (no)
@@ -213,66 +220,83 @@ private:
 			so the the **Value** in std::map **updated_zone_pairs** is variant
 			* std::pair<C, B>
 			* **zone_pair** CB in case of duplicate
+
+			the CB distances of all **updated_zone_pairs** are
+			computed together by **zone_pair_distance_updater**
 		end note
 	end while
 
+	:update **zone_pair_queue** with **updated_zone_pairs**;
+
 	stop
 
 	@enduml
 	*/
 
-	template <class ZonePairIterator, class ZoneFusion, class OutputDuplicateZonePair> void update_zone_pairs(ZonePairIterator zone_pair, ZonePairIterator end_zone_pair, ZoneFusion &zone_fusion, OutputDuplicateZonePair duplicate_zone_pairs) const {
+	template <class ZonePairIteratorRange, class ZoneFusion, class ZonePairQueue, class OutputDuplicateZonePair> void update_zone_pairs(const ZonePairIteratorRange &zone_pairs, ZoneFusion &zone_fusion, ZonePairQueue &zone_pair_queue, OutputDuplicateZonePair duplicate_zone_pairs) const {
+
+		typedef typename boost::range_value<ZonePairIteratorRange>::type zone_pair_iterator_type;
+		typedef typename boost::range_iterator<const ZonePairIteratorRange>::type incident_zone_pair_iterator_type;
 
 		typedef typename ZoneFusion::zone_type zone_type;
 		typedef boost::reference_wrapper<zone_type> zone_reference_type;
 		typedef std::pair<zone_reference_type, zone_reference_type> zone_pair_reference_type;
-		typedef boost::variant<ZonePairIterator, zone_pair_reference_type> value_type;
-		typedef std::map<ZonePairIterator, value_type, zone_pair_iterator_id_comparator> updated_zone_pairs_type;
+		typedef boost::variant<zone_pair_iterator_type, zone_pair_reference_type> value_type;
+		typedef std::map<zone_pair_iterator_type, value_type, zone_pair_iterator_id_comparator> updated_zone_pairs_type;
 		typedef typename updated_zone_pairs_type::iterator updated_zone_pair_iterator_type;
 		typedef boost::optional<zone_reference_type> updated_zone_type;
 
 		updated_zone_pairs_type updated_zone_pairs;
-		for(; zone_pair != end_zone_pair; ++zone_pair) {
+		for(incident_zone_pair_iterator_type zone_pair_iterator = boost::begin(zone_pairs); zone_pair_iterator != boost::end(zone_pairs); ++zone_pair_iterator) {
+			zone_pair_iterator_type zone_pair = *zone_pair_iterator;
 			updated_zone_type updated_zone = zone_pair->update_zones(zone_fusion);
 			if(updated_zone) {
 				std::pair<updated_zone_pair_iterator_type, bool> insert_result = updated_zone_pairs.insert(std::make_pair(zone_pair, make_zone_pair_to_compute_distance(boost::get(updated_zone), *zone_pair, zone_fusion)));
 				if(!insert_result.second) {
-					*duplicate_zone_pairs = zone_pair;
-					insert_result.first->second = zone_pair;
+					zone_pair_iterator_type first_zone_pair = insert_result.first->first;
+					if(zone_pair_queue.precedes(zone_pair, first_zone_pair)) {
+						updated_zone_pairs.erase(insert_result.first);
+						updated_zone_pairs.insert(std::make_pair(zone_pair, value_type(first_zone_pair)));
+						*duplicate_zone_pairs = first_zone_pair;
+					} else {
+						insert_result.first->second = zone_pair;
+						*duplicate_zone_pairs = zone_pair;
+					}
 				}
 			}
 		}
-		boost::for_each(updated_zone_pairs, zone_pair_distance_updater);
+		zone_pair_distance_updater.update_zone_pair_distances(updated_zone_pairs);
+		boost::for_each(updated_zone_pairs | boost::adaptors::map_keys, update_zone_pair_queue<ZonePairQueue>(zone_pair_queue));
 	}
 
-	template <class ZonePairIteratorContainer> struct remove_from_zone_pairs_to_merge {
+	template <class ZonePairQueue> struct update_zone_pair_queue {
 
-		remove_from_zone_pairs_to_merge(ZonePairIteratorContainer &zone_pairs_to_merge) : zone_pairs_to_merge(zone_pairs_to_merge) {}
+		update_zone_pair_queue(ZonePairQueue &zone_pair_queue) : zone_pair_queue(zone_pair_queue) {}
 
-		template <class ZonePairIterator> void operator()(const ZonePairIterator &zone_pair_iterator) const {
-			zone_pairs_to_merge.remove(zone_pair_iterator);
+		template <class zone_pair_iterator_type> void operator()(const zone_pair_iterator_type &zone_pair_iterator) const {
+			zone_pair_queue.update(zone_pair_iterator);
 		}
 
-		ZonePairIteratorContainer &zone_pairs_to_merge;
+		ZonePairQueue &zone_pair_queue;
 	};
 
-	template <class ZonePairIteratorContainer, class DuplicateZonePairRange> void remove_zone_pairs_to_merge(ZonePairIteratorContainer &zone_pairs_to_merge, const DuplicateZonePairRange &duplicate_zone_pairs) const {
-		boost::for_each(duplicate_zone_pairs, remove_from_zone_pairs_to_merge<ZonePairIteratorContainer>(zone_pairs_to_merge));
-	}
-
-	template <class ZonePairContainer> struct remove_from_zone_pairs {
+	template <class ZonePairContainer, class ZonePairQueue, class ZonePairAdjacency> struct remove_from_zone_pairs {
 
-		remove_from_zone_pairs(ZonePairContainer &zone_pairs) : zone_pairs(zone_pairs) {}
+		remove_from_zone_pairs(ZonePairContainer &zone_pairs, ZonePairQueue &zone_pair_queue, ZonePairAdjacency &zone_pair_adjacency) : zone_pairs(zone_pairs), zone_pair_queue(zone_pair_queue), zone_pair_adjacency(zone_pair_adjacency) {}
 
 		template <class ZonePairIterator> void operator()(const ZonePairIterator &zone_pair_iterator) const {
+			zone_pair_queue.erase(zone_pair_iterator);
+			zone_pair_adjacency.erase(zone_pair_iterator);
 			zone_pairs.erase(zone_pair_iterator);
 		}
 
 		ZonePairContainer &zone_pairs;
+		ZonePairQueue &zone_pair_queue;
+		ZonePairAdjacency &zone_pair_adjacency;
 	};
 
-	template <class ZonePairContainer, class DuplicateZonePairRange> void remove_zone_pairs(ZonePairContainer &zone_pairs, const DuplicateZonePairRange &duplicate_zone_pairs) const {
-		boost::for_each(duplicate_zone_pairs, remove_from_zone_pairs<ZonePairContainer>(zone_pairs));
+	template <class ZonePairContainer, class ZonePairQueue, class ZonePairAdjacency, class DuplicateZonePairRange> void remove_zone_pairs(ZonePairContainer &zone_pairs, ZonePairQueue &zone_pair_queue, ZonePairAdjacency &zone_pair_adjacency, const DuplicateZonePairRange &duplicate_zone_pairs) const {
+		boost::for_each(duplicate_zone_pairs, remove_from_zone_pairs<ZonePairContainer, ZonePairQueue, ZonePairAdjacency>(zone_pairs, zone_pair_queue, zone_pair_adjacency));
 	}
 };
 
@@ -42,6 +42,7 @@
 #include <CGAL/Boolean_set_operations_2.h>
 #include <geofis/geometry/circulator.hpp>
 #include <geofis/geometry/polygon.hpp>
+#include <geofis/geometry/clip/convex_polygon_clipper.hpp>
 #include <geofis/geometry/halfedge/voronoi/ccb_halfedge_circulator_adaptor.hpp>
 #include <geofis/geometry/halfedge/halfedge_source_point_range.hpp>
 #include <geofis/geometry/halfedge/delaunay/halfhedge_arrangement.hpp>
@@ -49,6 +50,28 @@
 
 namespace geofis {
 
+/*
+@startuml
+
+title bounded face to polygon class diagram
+
+class bounded_face_to_polygon<Polygon> {
+	- boundary_set : General_polygon_set_2
+	- boundary_clipper : convex_polygon_clipper
+	+ bounded_face_to_polygon(boundary: Polygon)
+	+ operator()(face: Face) : Polygon
+}
+
+note right of bounded_face_to_polygon
+	the boundary set and the boundary clipper are built once for all the faces:
+	the faces inside the boundary are returned as is, the faces crossing the boundary
+	are clipped by the convex polygon clipper, and only the faces touching the boundary
+	at a vertex are overlaid with the arrangement of the boundary set
+end note
+
+@enduml
+*/
+
 template <class Polygon> class bounded_face_to_polygon {};
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -64,7 +87,7 @@ template <class Kernel> class bounded_face_to_polygon<CGAL::Polygon_2<Kernel> >
 public:
 	typedef polygon_type result_type;
 
-	bounded_face_to_polygon(const polygon_type &boundary) : boundary(boundary) {
+	bounded_face_to_polygon(const polygon_type &boundary) : boundary_set(boundary), boundary_clipper(boundary) {
 		UTIL_REQUIRE(boundary.is_simple());
 	}
 
@@ -74,14 +97,15 @@ public:
 	}
 
 private:
-	polygon_type boundary;
+	general_polygon_set_type boundary_set;
+	convex_polygon_clipper<Kernel> boundary_clipper;
 
-	template <class Circulator> result_type get_polygon(const general_polygon_set_type &boundary, const Circulator &circulator, const point_type &face_point) const {
+	template <class Circulator> result_type get_overlay_polygon(const Circulator &circulator, const point_type &face_point) const {
 		arrangement_type face_arrangement;
 		insert(face_arrangement, circulator, circulator);
 		arrangement_type result_arrangement;
 		face_to_polygon_overlay_traits<arrangement_type> overlay_traits(face_point);
-		CGAL::overlay(boundary.arrangement(), face_arrangement, result_arrangement, overlay_traits);
+		CGAL::overlay(boundary_set.arrangement(), face_arrangement, result_arrangement, overlay_traits);
 		return overlay_traits.get_polygon();
 	}
 
@@ -94,7 +118,8 @@ private:
 	}
 
 	template <class Circulator> result_type get_polygon(const polygon_type &polygon, const Circulator &circulator, const point_type &face_point) const {
-		return CGAL::do_intersect(polygon, boundary) ? get_polygon(general_polygon_set_type(boundary), circulator, face_point) : polygon;
+		typename convex_polygon_clipper<Kernel>::result_type clipped_polygon = boundary_clipper.clip(polygon, face_point);
+		return clipped_polygon ? *clipped_polygon : get_overlay_polygon(circulator, face_point);
 	}
 };
 
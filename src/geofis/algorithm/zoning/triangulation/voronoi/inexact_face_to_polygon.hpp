@@ -0,0 +1,237 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef INEXACT_FACE_TO_POLYGON_HPP_
+#define INEXACT_FACE_TO_POLYGON_HPP_
+
+#include <vector>
+#include <utility>
+#include <CGAL/Ray_2.h>
+#include <CGAL/Iso_rectangle_2.h>
+#include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <geofis/geometry/clip/convex_polygon_clipper.hpp>
+#include <geofis/geometry/halfedge/delaunay/halfedge_to_ray.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title inexact face to polygon class diagram
+
+class inexact_face_to_polygon<Polygon> {
+	+ inexact_face_to_polygon(boundary: Polygon)
+	+ operator()(face: Face) : Polygon
+}
+
+note right of inexact_face_to_polygon
+	the voronoi vertices are the circumcenters of the delaunay faces constructed with
+	Exact_predicates_inexact_constructions_kernel, the same delaunay face gives the same
+	rounded vertex to all the voronoi faces sharing it, so the voronoi polygons still tile
+	the boundary with shared vertices:
+	the rounded vertices are doubles, so the exact predicates and the clipping by the boundary
+	stay in the filtered path of the exact kernel
+end note
+
+note bottom of inexact_face_to_polygon
+	the unbounded faces are closed by a box around the boundary and their vertices,
+	an empty polygon is returned when the rounded face is not simple, not counterclockwise
+	or does not contain its point: the voronoi map is then computed again with the exact kernel,
+	CGAL arrangements with inexact constructions are not robust, so the clipping itself stays exact:
+	the faces are clipped by the convex polygon clipper, and by the boolean set operations
+	when they touch the boundary at a vertex
+end note
+
+@enduml
+*/
+
+template <class Polygon> class inexact_face_to_polygon {};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Kernel> class inexact_face_to_polygon<CGAL::Polygon_2<Kernel> > {
+
+	typedef CGAL::Exact_predicates_inexact_constructions_kernel inexact_kernel_type;
+	typedef CGAL::Point_2<inexact_kernel_type> inexact_point_type;
+	typedef CGAL::Point_2<Kernel> point_type;
+	typedef CGAL::Ray_2<Kernel> ray_type;
+	typedef CGAL::Iso_rectangle_2<Kernel> box_type;
+	typedef CGAL::Polygon_2<Kernel> polygon_type;
+	typedef CGAL::Polygon_with_holes_2<Kernel> polygon_with_holes_type;
+	typedef std::vector<point_type> point_container_type;
+
+public:
+	typedef polygon_type result_type;
+
+	inexact_face_to_polygon(const polygon_type &boundary) : boundary(boundary), boundary_bbox(boundary.bbox()), boundary_clipper(boundary) {
+		UTIL_REQUIRE(boundary.is_simple());
+	}
+
+	//! returns the polygon of **face** clipped by the boundary, or an empty polygon when the rounded face is not valid
+	template <class Face> result_type operator() (Face &face) const {
+		UTIL_REQUIRE(face.is_valid());
+		const point_type &face_point = face.dual()->point();
+		polygon_type polygon = face.is_unbounded() ? get_unbounded_polygon(face.outer_ccb()) : get_bounded_polygon(face.outer_ccb());
+		if(!is_valid(polygon, face_point))
+			return result_type();
+		typename convex_polygon_clipper<Kernel>::result_type clipped_polygon = boundary_clipper.clip(polygon, face_point);
+		return clipped_polygon ? *clipped_polygon : get_clipped_polygon(polygon, face_point);
+	}
+
+private:
+	polygon_type boundary;
+	CGAL::Bbox_2 boundary_bbox;
+	convex_polygon_clipper<Kernel> boundary_clipper;
+
+	template <class Vertex> static point_type get_vertex_point(const Vertex &vertex) {
+		auto delaunay_face = vertex->dual();
+		inexact_point_type circumcenter = CGAL::circumcenter(get_inexact_point(delaunay_face->vertex(0)->point()), get_inexact_point(delaunay_face->vertex(1)->point()), get_inexact_point(delaunay_face->vertex(2)->point()));
+		return point_type(circumcenter.x(), circumcenter.y());
+	}
+
+	static inexact_point_type get_inexact_point(const point_type &point) {
+		return inexact_point_type(CGAL::to_double(point.x()), CGAL::to_double(point.y()));
+	}
+
+	static void push_point(point_container_type &points, const point_type &point) {
+		if(points.empty() || points.back() != point)
+			points.push_back(point);
+	}
+
+	template <class Circulator> result_type get_bounded_polygon(Circulator circulator) const {
+		point_container_type points;
+		Circulator end = circulator;
+		CGAL_For_all(circulator, end)
+			push_point(points, get_vertex_point(circulator->source()));
+		return make_polygon(points);
+	}
+
+	template <class Circulator> result_type get_unbounded_polygon(Circulator circulator) const {
+		point_container_type points;
+		box_type box = get_box(circulator);
+		Circulator end = circulator;
+		CGAL_For_all(circulator, end) {
+			if(circulator->has_source())
+				push_point(points, get_vertex_point(circulator->source()));
+			if(!circulator->has_target()) {
+				point_type exit_point = get_exit_point(get_inexact_ray(*circulator), box);
+				push_point(points, exit_point);
+				push_box_corners(points, exit_point, get_exit_point(get_inexact_ray(*boost::next(circulator)), box), box);
+			}
+			if(!circulator->has_source())
+				push_point(points, get_exit_point(get_inexact_ray(*circulator), box));
+		}
+		return make_polygon(points);
+	}
+
+	static result_type make_polygon(point_container_type &points) {
+		if(points.size() > 1 && points.front() == points.back())
+			points.pop_back();
+		return result_type(points.begin(), points.end());
+	}
+
+	template <class Halfedge> static ray_type get_inexact_ray(const Halfedge &halfedge) {
+		return ray_type(get_vertex_point(halfedge.has_source() ? halfedge.source() : halfedge.target()), get_ray_direction(halfedge));
+	}
+
+	// the box contains the boundary and the vertices of the face, so each ray of the face exits the box once
+	template <class Circulator> box_type get_box(Circulator circulator) const {
+		CGAL::Bbox_2 bbox = boundary_bbox;
+		Circulator end = circulator;
+		CGAL_For_all(circulator, end)
+			if(circulator->has_source())
+				bbox += get_vertex_point(circulator->source()).bbox();
+		double margin = 1.0 + (bbox.xmax() - bbox.xmin()) + (bbox.ymax() - bbox.ymin());
+		return box_type(point_type(bbox.xmin() - margin, bbox.ymin() - margin), point_type(bbox.xmax() + margin, bbox.ymax() + margin));
+	}
+
+	static point_type get_exit_point(const ray_type &ray, const box_type &box) {
+		auto intersection = CGAL::intersection(ray, box);
+		UTIL_ASSERT(intersection);
+		const typename Kernel::Segment_2 *segment = boost::get<typename Kernel::Segment_2>(&*intersection);
+		return segment ? segment->target() : *boost::get<point_type>(&*intersection);
+	}
+
+	// the position of a point on the box boundary, counterclockwise from the bottom left corner
+	static std::pair<int, typename Kernel::FT> get_box_position(const point_type &point, const box_type &box) {
+		if(point.y() == box.ymin() && point.x() != box.xmax())
+			return std::make_pair(0, point.x());
+		if(point.x() == box.xmax() && point.y() != box.ymax())
+			return std::make_pair(1, point.y());
+		if(point.y() == box.ymax() && point.x() != box.xmin())
+			return std::make_pair(2, -point.x());
+		return std::make_pair(3, -point.y());
+	}
+
+	// the corners of the box from **exit_point** to **entry_point**, counterclockwise so the face is on the left side
+	static void push_box_corners(point_container_type &points, const point_type &exit_point, const point_type &entry_point, const box_type &box) {
+		std::pair<int, typename Kernel::FT> exit_position = get_box_position(exit_point, box);
+		std::pair<int, typename Kernel::FT> entry_position = get_box_position(entry_point, box);
+		int side = exit_position.first;
+		bool full_turn = side == entry_position.first && entry_position.second < exit_position.second;
+		while(side != entry_position.first || full_turn) {
+			side = (side + 1) % 4;
+			push_point(points, box.vertex(side));
+			full_turn = false;
+		}
+	}
+
+	static bool is_valid(const polygon_type &polygon, const point_type &face_point) {
+		return polygon.size() > 2 && polygon.is_simple() && polygon.is_counterclockwise_oriented() && polygon.bounded_side(face_point) == CGAL::ON_BOUNDED_SIDE;
+	}
+
+	result_type get_clipped_polygon(const polygon_type &polygon, const point_type &face_point) const {
+		std::vector<polygon_with_holes_type> intersections;
+		CGAL::intersection(polygon, boundary, std::back_inserter(intersections));
+		for(const polygon_with_holes_type &intersection : intersections)
+			if(intersection.outer_boundary().bounded_side(face_point) != CGAL::ON_UNBOUNDED_SIDE)
+				return intersection.outer_boundary();
+		return result_type();
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Polygon> inline inexact_face_to_polygon<Polygon> make_inexact_face_to_polygon(const Polygon &boundary) {
+	return inexact_face_to_polygon<Polygon>(boundary);
+}
+
+} // namespace geofis
+
+#endif /* INEXACT_FACE_TO_POLYGON_HPP_ */
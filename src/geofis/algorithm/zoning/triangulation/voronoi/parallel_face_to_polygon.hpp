@@ -0,0 +1,297 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef PARALLEL_FACE_TO_POLYGON_HPP_
+#define PARALLEL_FACE_TO_POLYGON_HPP_
+
+#include <vector>
+#include <utility>
+#include <boost/optional.hpp>
+#include <CGAL/Ray_2.h>
+#include <CGAL/Segment_2.h>
+#include <CGAL/Polygon_2.h>
+#include <CGAL/Triangulation_utils_2.h>
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <util/assert.hpp>
+#include <util/algorithm/parallel_for_each_chunk.hpp>
+#include <geofis/geometry/unshared_geometry.hpp>
+#include <geofis/geometry/clip/convex_polygon_clipper.hpp>
+#include <geofis/geometry/halfedge/delaunay/halfedge_to_ray.hpp>
+#include <geofis/algorithm/zoning/triangulation/voronoi/unbounded_face_to_polygon.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title parallel face to polygon class diagram
+
+class parallel_face_to_polygon<Polygon> {
+	- boundary : Polygon
+	- thread_count : size_t
+	- face_records : face_record [0..*]
+	+ parallel_face_to_polygon(boundary: Polygon, thread_count: size_t)
+	+ push_face(face: Face) : bool
+	+ convert()
+	+ get_polygon(index: size_t) : Polygon [0..1]
+}
+
+class face_record {
+	+ unbounded : bool
+	+ point : Point_2
+	+ halfedge_kinds : halfedge_kind [0..*]
+	+ points : Point_2 [0..*]
+	+ polygon : Polygon [0..1]
+}
+
+parallel_face_to_polygon *-- "0..*" face_record
+
+note right of parallel_face_to_polygon
+	the lazy numbers of the voronoi vertices share their representations with the delaunay points,
+	and their reference counts are not atomic: a face is pushed with the double coordinates of its point
+	and of the delaunay points defining its halfedges, then each chunk of faces constructs its halfedges
+	again from these coordinates on its own thread, and clips them with its own unshared boundary:
+	a bounded face with the convex polygon clipper, an unbounded face with the boundary arrangement
+end note
+
+note bottom of parallel_face_to_polygon
+	the halfedges constructed again have the same exact points as the voronoi halfedges, so the polygons
+	are the ones of face_to_polygon, a face is not pushed when a coordinate is not a double,
+	and no polygon is returned when the convex polygon clipper fails: the face is then converted
+	on the calling thread
+end note
+
+@enduml
+*/
+
+template <class Polygon> class parallel_face_to_polygon;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Kernel> class parallel_face_to_polygon<CGAL::Polygon_2<Kernel> > {
+
+	typedef CGAL::Point_2<Kernel> point_type;
+	typedef CGAL::Ray_2<Kernel> ray_type;
+	typedef CGAL::Segment_2<Kernel> segment_type;
+	typedef CGAL::Polygon_2<Kernel> polygon_type;
+	typedef CGAL::Exact_predicates_inexact_constructions_kernel::Point_2 double_point_type;
+	typedef std::vector<double_point_type> double_point_container_type;
+	typedef convex_polygon_clipper<Kernel> convex_polygon_clipper_type;
+	typedef unbounded_face_to_polygon<polygon_type> unbounded_face_to_polygon_type;
+	typedef typename unbounded_face_to_polygon_type::arrangement_type arrangement_type;
+
+	// the points of a halfedge: the delaunay triangles of its target and its source for a segment,
+	// the delaunay triangle of its vertex and the two delaunay points of its direction for a ray,
+	// the two delaunay points of its line for a bisector
+	enum halfedge_kind { segment_halfedge, ray_halfedge, bisector_halfedge };
+
+	struct face_record {
+		bool unbounded;
+		double_point_type point;
+		//! the halfedge kinds of an unbounded face, empty for a bounded face
+		std::vector<halfedge_kind> halfedge_kinds;
+		//! the points of each halfedge of an unbounded face, or the delaunay triangle of each vertex of a bounded face
+		double_point_container_type points;
+		boost::optional<polygon_type> polygon;
+	};
+
+	typedef std::vector<face_record> face_record_container_type;
+
+	// the face to polygon of a chunk, with its own unshared boundary
+	struct chunk_face_to_polygon {
+
+		convex_polygon_clipper_type bounded;
+		unbounded_face_to_polygon_type unbounded;
+
+		chunk_face_to_polygon(const polygon_type &boundary) : bounded(boundary), unbounded(boundary) {}
+
+		void operator()(face_record &face_record) const {
+			point_type face_point = get_point(face_record.point);
+			if(face_record.unbounded)
+				face_record.polygon = unbounded(get_unbounded_arrangement(face_record), face_point);
+			else
+				face_record.polygon = bounded.clip(get_bounded_polygon(face_record.points), face_point);
+		}
+	};
+
+	typedef std::vector<chunk_face_to_polygon> chunk_face_to_polygon_container_type;
+
+	struct face_record_converter {
+
+		face_record_container_type &face_records;
+		const chunk_face_to_polygon_container_type &chunk_face_to_polygons;
+
+		face_record_converter(face_record_container_type &face_records, const chunk_face_to_polygon_container_type &chunk_face_to_polygons) : face_records(face_records), chunk_face_to_polygons(chunk_face_to_polygons) {}
+
+		// the faces are dealt to the chunks in turn, so the unbounded faces pushed first are shared between the threads
+		void operator()(size_t chunk, size_t, size_t) const {
+			for(size_t index = chunk; index < face_records.size(); index += chunk_face_to_polygons.size())
+				chunk_face_to_polygons[chunk](face_records[index]);
+		}
+	};
+
+public:
+	typedef boost::optional<polygon_type> result_type;
+
+	parallel_face_to_polygon(const polygon_type &boundary, size_t thread_count) : boundary(boundary), thread_count(thread_count) {
+		UTIL_REQUIRE(boundary.is_simple());
+		UTIL_REQUIRE(thread_count > 0);
+	}
+
+	size_t size() const {
+		return face_records.size();
+	}
+
+	//! pushes **face**, or returns false when a coordinate of its point or of the delaunay points of its halfedges is not a double
+	template <class Face> bool push_face(Face &face) {
+		UTIL_REQUIRE(face.is_valid());
+		face_record face_record;
+		face_record.unbounded = face.is_unbounded();
+		if(!get_double_point(face.dual()->point(), face_record.point))
+			return false;
+		auto circulator = face.outer_ccb();
+		auto end = circulator;
+		CGAL_For_all(circulator, end)
+			if(!(face_record.unbounded ? push_halfedge(face_record, *circulator) : push_triangle(face_record.points, circulator->source()->dual())))
+				return false;
+		face_records.push_back(face_record);
+		return true;
+	}
+
+	//! converts the pushed faces on **thread_count** threads
+	void convert() {
+		chunk_face_to_polygon_container_type chunk_face_to_polygons;
+		size_t chunk_count = util::get_chunk_count(face_records.size(), thread_count);
+		chunk_face_to_polygons.reserve(chunk_count);
+		for(size_t chunk = 0; chunk < chunk_count; ++chunk)
+			chunk_face_to_polygons.push_back(chunk_face_to_polygon(make_unshared_geometry(boundary)));
+		util::parallel_for_each_chunk(chunk_count, thread_count, face_record_converter(face_records, chunk_face_to_polygons));
+	}
+
+	//! returns the polygon of the face pushed at **index**, or none when the face must be converted on the calling thread
+	const result_type &get_polygon(size_t index) const {
+		return face_records[index].polygon;
+	}
+
+private:
+	polygon_type boundary;
+	size_t thread_count;
+	face_record_container_type face_records;
+
+	// false when a coordinate of **point** is not exactly a double
+	static bool get_double_point(const point_type &point, double_point_type &double_point) {
+		std::pair<double, double> x = CGAL::to_interval(point.x());
+		std::pair<double, double> y = CGAL::to_interval(point.y());
+		if(x.first != x.second || y.first != y.second)
+			return false;
+		double_point = double_point_type(x.first, y.first);
+		return true;
+	}
+
+	template <class Vertex> static bool push_point(double_point_container_type &points, const Vertex &vertex) {
+		double_point_type point;
+		if(!get_double_point(vertex->point(), point))
+			return false;
+		points.push_back(point);
+		return true;
+	}
+
+	template <class DelaunayFace> static bool push_triangle(double_point_container_type &points, const DelaunayFace &delaunay_face) {
+		return push_point(points, delaunay_face->vertex(0)) && push_point(points, delaunay_face->vertex(1)) && push_point(points, delaunay_face->vertex(2));
+	}
+
+	// the same points as halfedge_to_segment, halfedge_to_ray and halfedge_to_line
+	template <class Halfedge> static bool push_halfedge(face_record &face_record, const Halfedge &halfedge) {
+		double_point_container_type &points = face_record.points;
+		if(halfedge.is_segment()) {
+			face_record.halfedge_kinds.push_back(segment_halfedge);
+			return push_triangle(points, halfedge.target()->dual()) && push_triangle(points, halfedge.source()->dual());
+		}
+		if(halfedge.is_ray()) {
+			face_record.halfedge_kinds.push_back(ray_halfedge);
+			if(halfedge.has_source())
+				return push_triangle(points, halfedge.source()->dual()) && push_point(points, halfedge.down()) && push_point(points, halfedge.up());
+			return push_triangle(points, halfedge.target()->dual()) && push_point(points, halfedge.up()) && push_point(points, halfedge.down());
+		}
+		UTIL_REQUIRE(halfedge.is_bisector());
+		face_record.halfedge_kinds.push_back(bisector_halfedge);
+		auto delaunay_edge = halfedge.dual();
+		return push_point(points, delaunay_edge.first->vertex(CGAL::Triangulation_cw_ccw_2::cw(delaunay_edge.second))) && push_point(points, delaunay_edge.first->vertex(CGAL::Triangulation_cw_ccw_2::ccw(delaunay_edge.second)));
+	}
+
+	static point_type get_point(const double_point_type &point) {
+		return point_type(point.x(), point.y());
+	}
+
+	static point_type get_circumcenter(typename double_point_container_type::const_iterator triangle) {
+		return CGAL::circumcenter(get_point(triangle[0]), get_point(triangle[1]), get_point(triangle[2]));
+	}
+
+	static polygon_type get_bounded_polygon(const double_point_container_type &triangle_points) {
+		polygon_type polygon;
+		for(typename double_point_container_type::const_iterator triangle = triangle_points.begin(); triangle != triangle_points.end(); triangle += 3)
+			polygon.push_back(get_circumcenter(triangle));
+		return polygon;
+	}
+
+	static arrangement_type get_unbounded_arrangement(const face_record &face_record) {
+		arrangement_type arrangement;
+		typename double_point_container_type::const_iterator point = face_record.points.begin();
+		for(halfedge_kind kind : face_record.halfedge_kinds) {
+			switch(kind) {
+			case segment_halfedge:
+				CGAL::insert(arrangement, segment_type(get_circumcenter(point), get_circumcenter(point + 3)));
+				point += 6;
+				break;
+			case ray_halfedge:
+				CGAL::insert(arrangement, ray_type(get_circumcenter(point), get_ray_direction(get_point(point[3]), get_point(point[4]))));
+				point += 5;
+				break;
+			case bisector_halfedge:
+				CGAL::insert(arrangement, CGAL::bisector(get_point(point[0]), get_point(point[1])));
+				point += 2;
+				break;
+			}
+		}
+		return arrangement;
+	}
+};
+
+} // namespace geofis
+
+#endif /* PARALLEL_FACE_TO_POLYGON_HPP_ */
@@ -56,10 +56,10 @@ template <class Kernel> class unbounded_face_to_polygon<CGAL::Polygon_2<Kernel>
 	typedef CGAL::Point_2<Kernel>						point_type;
 	typedef CGAL::Polygon_2<Kernel> 					polygon_type;
 	typedef CGAL::Arr_linear_traits_2<Kernel>			linear_traits_type;
-	typedef CGAL::Arrangement_2<linear_traits_type>		arrangement_type;
 
 public:
 	typedef CGAL::Polygon_2<Kernel> result_type;
+	typedef CGAL::Arrangement_2<linear_traits_type> arrangement_type;
 
 	unbounded_face_to_polygon(const polygon_type &boundary) {
 		UTIL_REQUIRE(boundary.is_simple());
@@ -71,6 +71,14 @@ public:
 		return get_polygon(face.outer_ccb(), face.dual()->point());
 	}
 
+	//! returns the polygon of the face around **face_point** in the arrangement **face_arrangement** of the face halfedges, clipped by the boundary
+	result_type operator() (const arrangement_type &face_arrangement, const point_type &face_point) const {
+		arrangement_type result_arrangement;
+		face_to_polygon_overlay_traits<arrangement_type> overlay_traits(face_point);
+		CGAL::overlay(boundary_arrangement, face_arrangement, result_arrangement, overlay_traits);
+		return overlay_traits.get_polygon();
+	}
+
 private:
 
 	arrangement_type boundary_arrangement;
@@ -78,10 +86,7 @@ private:
 	template <class Circulator> result_type get_polygon(const Circulator &circulator, const point_type &face_point) const {
 		arrangement_type face_arrangement;
 		insert(face_arrangement, circulator, circulator);
-		arrangement_type result_arrangement;
-		face_to_polygon_overlay_traits<arrangement_type> overlay_traits(face_point);
-		CGAL::overlay(boundary_arrangement, face_arrangement, result_arrangement, overlay_traits);
-		return overlay_traits.get_polygon();
+		return (*this)(face_arrangement, face_point);
 	}
 };
 
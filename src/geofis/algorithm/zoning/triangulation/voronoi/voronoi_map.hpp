@@ -51,6 +51,8 @@
 #include <geofis/algorithm/zoning/triangulation/voronoi/voronoi_info.hpp>
 #include <geofis/algorithm/zoning/triangulation/voronoi/face_to_geometry.hpp>
 #include <geofis/algorithm/zoning/triangulation/voronoi/face_to_polygon.hpp>
+#include <geofis/algorithm/zoning/triangulation/voronoi/inexact_face_to_polygon.hpp>
+#include <geofis/algorithm/zoning/triangulation/voronoi/parallel_face_to_polygon.hpp>
 
 namespace geofis {
 
@@ -72,17 +74,20 @@ template <class Kernel, class Feature, class InfoPolicy = typename voronoi_map_t
 	typedef typename voronoi_traits<Kernel, info_type>::voronoi_diagram_type voronoi_diagram_type;
 	typedef typename delaunay_triangulation_type::Finite_edges_iterator finite_edge_iterator;
 	typedef std::vector<voronoi_zone_type> zone_container_type;
+	typedef typename voronoi_diagram_type::Face_iterator face_iterator;
 
 public:
 	typedef typename boost::sub_range<const zone_container_type>::type const_zone_range_type;
 	typedef typename boost::iterator_range<finite_edge_iterator> finite_edge_range_type;
 
-	template <class FeatureRange> void initialize(const FeatureRange &features, const geometry_type &boundary, InfoPolicy &info_policy) {
-		initialize(make_voronoi_zone_range<geometry_type>(features), features, boundary, info_policy);
+	//! with **inexact**, the voronoi vertices are constructed with the inexact kernel, the map is computed again with the exact kernel when a voronoi polygon is not valid,
+	//! otherwise the voronoi faces are converted to polygons clipped by the boundary on **thread_count** threads
+	template <class FeatureRange> void initialize(const FeatureRange &features, const geometry_type &boundary, InfoPolicy &info_policy, bool inexact = false, size_t thread_count = 1) {
+		initialize(make_voronoi_zone_range<geometry_type>(features), features, boundary, info_policy, inexact, thread_count);
 	}
 
-	template <class FeatureRange> void initialize(const FeatureRange &features, const geometry_type &boundary) {
-		initialize(features, boundary, InfoPolicy());
+	template <class FeatureRange> void initialize(const FeatureRange &features, const geometry_type &boundary, bool inexact = false, size_t thread_count = 1) {
+		initialize(features, boundary, InfoPolicy(), inexact, thread_count);
 	}
 
 	size_t size() const { return zones.size(); }
@@ -97,10 +102,13 @@ private:
 	zone_container_type zones;
 	delaunay_triangulation_type delaunay;
 
-	template <class ZoneRange, class FeatureRange> void initialize(const ZoneRange &zones, const FeatureRange &features, const geometry_type &boundary, InfoPolicy &info_policy) {
+	template <class ZoneRange, class FeatureRange> void initialize(const ZoneRange &zones, const FeatureRange &features, const geometry_type &boundary, InfoPolicy &info_policy, bool inexact, size_t thread_count) {
 		util::assign(this->zones, zones);
 		initialize_delaunay(features, info_policy);
-		initialize_zone_geometries_with_voronoi(boundary);
+		if(inexact)
+			initialize_zone_geometries_with_inexact_voronoi(boundary);
+		else
+			initialize_zone_geometries_with_voronoi(boundary, thread_count);
 	}
 
 	template <class FeatureRange> void initialize_delaunay(const FeatureRange &features, InfoPolicy &info_policy) {
@@ -112,13 +120,57 @@ private:
 		delaunay.insert(boost::make_zip_iterator(boost::make_tuple(boost::begin(geometries), boost::begin(infos))), boost::make_zip_iterator(boost::make_tuple(boost::end(geometries), boost::end(infos))));
 	}
 
-	void initialize_zone_geometries_with_voronoi(const geometry_type &boundary) {
-		initialize_zone_geometries_with_voronoi(voronoi_diagram_type(delaunay), boundary);
+	void initialize_zone_geometries_with_voronoi(const geometry_type &boundary, size_t thread_count) {
+		voronoi_diagram_type voronoi(delaunay);
+		if(thread_count > 1)
+			initialize_zone_geometries_with_voronoi_in_parallel(voronoi, boundary, thread_count);
+		else
+			initialize_zone_geometries_with_voronoi(voronoi, boundary);
 	}
 
 	void initialize_zone_geometries_with_voronoi(const voronoi_diagram_type &voronoi, const geometry_type &boundary) {
 		std::for_each(voronoi.faces_begin(), voronoi.faces_end(), make_face_to_geometry(make_face_to_polygon(boundary)));
 	}
+
+	// the voronoi diagram caches its degeneracies, so the faces are pushed from the calling thread, the unbounded faces first as they are the slowest to convert
+	void initialize_zone_geometries_with_voronoi_in_parallel(const voronoi_diagram_type &voronoi, const geometry_type &boundary, size_t thread_count) {
+		face_to_polygon<geometry_type> face_to_polygon(boundary);
+		parallel_face_to_polygon<geometry_type> parallel_face_to_polygon(boundary, thread_count);
+		std::vector<face_iterator> pushed_faces;
+		for(bool unbounded : {true, false}) {
+			for(face_iterator face = voronoi.faces_begin(); face != voronoi.faces_end(); ++face) {
+				if(face->is_unbounded() != unbounded)
+					continue;
+				if(parallel_face_to_polygon.push_face(*face))
+					pushed_faces.push_back(face);
+				else
+					face->dual()->info().set_geometry(face_to_polygon(*face));
+			}
+		}
+		parallel_face_to_polygon.convert();
+		for(size_t index = 0; index < pushed_faces.size(); ++index) {
+			const boost::optional<geometry_type> &polygon = parallel_face_to_polygon.get_polygon(index);
+			pushed_faces[index]->dual()->info().set_geometry(polygon ? *polygon : face_to_polygon(*pushed_faces[index]));
+		}
+	}
+
+	void initialize_zone_geometries_with_inexact_voronoi(const geometry_type &boundary) {
+		voronoi_diagram_type voronoi(delaunay);
+		if(delaunay.dimension() < 2 || !initialize_zone_geometries_with_inexact_voronoi(voronoi, boundary))
+			initialize_zone_geometries_with_voronoi(voronoi, boundary);
+	}
+
+	// all the zone geometries are computed again with the exact kernel when one inexact voronoi polygon is not valid
+	bool initialize_zone_geometries_with_inexact_voronoi(const voronoi_diagram_type &voronoi, const geometry_type &boundary) {
+		inexact_face_to_polygon<geometry_type> face_to_polygon(boundary);
+		for(typename voronoi_diagram_type::Face_iterator face = voronoi.faces_begin(); face != voronoi.faces_end(); ++face) {
+			geometry_type geometry = face_to_polygon(*face);
+			if(geometry.is_empty())
+				return false;
+			face->dual()->info().set_geometry(geometry);
+		}
+		return true;
+	}
 };
 
 } // namespace geofis
@@ -0,0 +1,108 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef ATTRIBUTE_BLOCK_HPP_
+#define ATTRIBUTE_BLOCK_HPP_
+
+#include <vector>
+#include <boost/range/iterator_range.hpp>
+#include <boost/align/aligned_allocator.hpp>
+#include <util/assert.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title attribute_block class diagram
+
+class attribute_block<Attribute> {
+	- row_size : size_t
+	- attributes : Attribute [0..*]
+	+ get_row_size() : size_t
+	+ get_row_count() : size_t
+	+ get_row(index: size_t) : row_range_type
+}
+
+note right
+	row-major block, the row **index** holds the
+	attributes of the feature **index**, the block
+	is aligned on a cache line
+end note
+
+@enduml
+*/
+
+template <class Attribute> class attribute_block {
+
+	typedef std::vector<Attribute, boost::alignment::aligned_allocator<Attribute, 64> > attribute_container_type;
+
+public:
+	typedef boost::iterator_range<Attribute *> row_range_type;
+	typedef boost::iterator_range<const Attribute *> const_row_range_type;
+
+	attribute_block(size_t row_count, size_t row_size) : row_size(row_size), attributes(row_count * row_size) {}
+
+	size_t get_row_size() const {
+		return row_size;
+	}
+
+	size_t get_row_count() const {
+		return row_size == 0 ? 0 : attributes.size() / row_size;
+	}
+
+	row_range_type get_row(size_t index) {
+		UTIL_REQUIRE(index < get_row_count());
+		Attribute *row = attributes.data() + index * row_size;
+		return row_range_type(row, row + row_size);
+	}
+
+	const_row_range_type get_row(size_t index) const {
+		UTIL_REQUIRE(index < get_row_count());
+		const Attribute *row = attributes.data() + index * row_size;
+		return const_row_range_type(row, row + row_size);
+	}
+
+private:
+	size_t row_size;
+	attribute_container_type attributes;
+};
+
+} // namespace geofis
+
+#endif /* ATTRIBUTE_BLOCK_HPP_ */
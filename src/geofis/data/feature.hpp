@@ -42,6 +42,8 @@
 #include <cstddef>
 #include <functional>
 #include <boost/variant.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/mpl/contains.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/type_traits/is_same.hpp>
@@ -49,8 +51,9 @@
 #include <boost/range/sub_range.hpp>
 #include <boost/range/algorithm/for_each.hpp>
 #include <boost/range/algorithm/equal.hpp>
+#include <boost/range/algorithm/copy.hpp>
 #include <util/assert.hpp>
-#include <util/range/assign.hpp>
+#include <geofis/data/attribute_block.hpp>
 #include <geofis/data/default_attribute_type.hpp>
 #include <geofis/data/attribute_equality.hpp>
 #include <geofis/data/is_monodimensional_feature.hpp>
@@ -69,6 +72,11 @@ class multidimensional_feature<Id, Geometry, AttributeRange> {
 - normalized_attributes: Attribute [0..*]
 }
 
+note right of multidimensional_feature
+	normalized_attributes is a row of an
+	attribute_block shared by the features
+end note
+
 feature <|.down. multidimensional_feature: <<bind>> \n <IsMonoAttribute -> false>
 
 class monodimensional_feature<Id, Geometry, Attribute> {
@@ -139,6 +147,8 @@ public:
 
 	typedef typename boost::range_iterator<const AttributeRange>::type const_attribute_iterator_type;
 	typedef typename boost::sub_range<const AttributeRange>::type const_attribute_range_type;
+	typedef attribute_block<attribute_type> attribute_block_type;
+	typedef typename attribute_block_type::const_row_range_type const_normalized_attribute_range_type;
 
 	feature(Id id, const Geometry &geometry, const AttributeRange &attributes) : id(id), geometry(geometry), attributes(attributes) {}
 	template <class OtherAttributeRange> feature(Id id, const Geometry &geometry, const OtherAttributeRange &other_attributes) : id(id), geometry(geometry), attributes(boost::begin(other_attributes), boost::end(other_attributes)) {}
@@ -153,14 +163,22 @@ public:
 
 	const_attribute_range_type get_attribute_range() const { return attributes; }
 
-	const_attribute_range_type get_normalized_attribute_range() const { return normalized_attributes; }
+	const_normalized_attribute_range_type get_normalized_attribute_range() const { return normalized_attributes; }
 
 	template <class OtherAttributeRange> void set_normalized_attribute_range(const OtherAttributeRange &normalized_attributes) {
 
 		BOOST_MPL_ASSERT((boost::is_same<typename boost::range_value<AttributeRange>::type, typename boost::range_value<OtherAttributeRange>::type>));
 
 		UTIL_REQUIRE(boost::size(normalized_attributes) == get_attribute_size());
-		util::assign(this->normalized_attributes, normalized_attributes);
+		boost::shared_ptr<attribute_block_type> normalized_attribute_block = boost::make_shared<attribute_block_type>(1, get_attribute_size());
+		boost::copy(normalized_attributes, boost::begin(normalized_attribute_block->get_row(0)));
+		set_normalized_attribute_block(normalized_attribute_block, 0);
+	}
+
+	void set_normalized_attribute_block(const boost::shared_ptr<const attribute_block_type> &normalized_attribute_block, size_t index) {
+		UTIL_REQUIRE(normalized_attribute_block->get_row_size() == get_attribute_size());
+		this->normalized_attribute_block = normalized_attribute_block;
+		this->normalized_attributes = normalized_attribute_block->get_row(index);
 	}
 
 	size_t get_attribute_size() const { return boost::size(attributes); }
@@ -175,7 +193,8 @@ private:
     Id id;
 	Geometry geometry;
 	AttributeRange attributes;
-	AttributeRange normalized_attributes;
+	boost::shared_ptr<const attribute_block_type> normalized_attribute_block;
+	const_normalized_attribute_range_type normalized_attributes;
 
 	template <class Visitor> struct internal_attribute_visitor : public boost::static_visitor<void> {
 
@@ -0,0 +1,250 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef CONVEX_POLYGON_CLIPPER_HPP_
+#define CONVEX_POLYGON_CLIPPER_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <boost/optional.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <CGAL/Line_2.h>
+#include <CGAL/Point_2.h>
+#include <CGAL/Polygon_2.h>
+#include <CGAL/intersections.h>
+#include <util/assert.hpp>
+#include <geofis/geometry/clip/segment_grid.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title convex polygon clipper class diagram
+
+class convex_polygon_clipper<Kernel> {
+	- boundary : Polygon_2
+	- boundary_grid : segment_grid
+	+ convex_polygon_clipper(boundary: Polygon_2)
+	+ clip(polygon: Polygon_2, point: Point_2) : Polygon_2 [0..1]
+}
+
+convex_polygon_clipper *-- "1" segment_grid
+
+note right of convex_polygon_clipper
+	clips a convex polygon, as a voronoi polygon, by the boundary, the clipped polygon
+	is the part of the intersection containing the point, itself inside or on the boundary:
+	the polygon not crossed by a boundary edge is inside the boundary and is returned as is,
+	otherwise the boundary chains inside the polygon are linked by the polygon arcs
+	inside the boundary, walking counterclockwise from each exit to the next entry
+end note
+
+note bottom of convex_polygon_clipper
+	the crossings are the intersections of the supporting lines with the exact kernel,
+	so two neighbor polygons clipped by the same boundary edge share the same vertex:
+	no polygon is returned when a boundary vertex is on the polygon boundary,
+	when a polygon vertex is on the boundary, or when the polygon is not convex,
+	the caller then clips the polygon with the boolean set operations
+end note
+
+@enduml
+*/
+
+template <class Kernel> class convex_polygon_clipper {
+
+	typedef CGAL::Point_2<Kernel> point_type;
+	typedef CGAL::Line_2<Kernel> line_type;
+	typedef CGAL::Polygon_2<Kernel> polygon_type;
+	typedef std::vector<point_type> point_container_type;
+	typedef std::vector<size_t> index_container_type;
+
+	// the point where the boundary edge crosses the polygon edge
+	struct crossing {
+		size_t boundary_edge;
+		size_t polygon_edge;
+		point_type point;
+		bool entry;
+	};
+
+	typedef std::vector<crossing> crossing_container_type;
+
+public:
+	typedef boost::optional<polygon_type> result_type;
+
+	convex_polygon_clipper(const polygon_type &boundary) : boundary(boundary) {
+		UTIL_REQUIRE(boundary.is_simple());
+		if(this->boundary.is_clockwise_oriented())
+			this->boundary.reverse_orientation();
+		boundary_grid = segment_grid(boost::make_iterator_range(this->boundary.edges_begin(), this->boundary.edges_end()));
+	}
+
+	//! returns **polygon** clipped by the boundary around **point**, or none when the polygon is not convex or touches the boundary at a vertex
+	result_type clip(const polygon_type &polygon, const point_type &point) const {
+		index_container_type boundary_edges;
+		boundary_grid.get_segments(polygon.bbox(), boundary_edges);
+		if(boundary_edges.empty())
+			return polygon;
+		if(!polygon.is_convex() || !polygon.is_counterclockwise_oriented())
+			return result_type();
+		crossing_container_type crossings;
+		bool boundary_inside = false;
+		for(size_t boundary_edge : boundary_edges) {
+			CGAL::Bounded_side side = polygon.bounded_side(boundary[boundary_edge]);
+			if(side == CGAL::ON_BOUNDARY || !push_crossings(crossings, polygon, boundary_edge, side == CGAL::ON_BOUNDED_SIDE))
+				return result_type();
+			boundary_inside |= side == CGAL::ON_BOUNDED_SIDE;
+		}
+		// without crossing, the boundary is inside the polygon or the polygon is inside the boundary, as the point
+		if(crossings.empty())
+			return boundary_inside ? boundary : polygon;
+		return get_clipped_polygon(polygon, point, crossings);
+	}
+
+private:
+	polygon_type boundary;
+	segment_grid boundary_grid;
+
+	template <class Ring> static size_t get_next_index(const Ring &ring, size_t index) {
+		return index + 1 == ring.size() ? 0 : index + 1;
+	}
+
+	// pushes the crossings of the boundary edge with the polygon edges, ordered from the edge source, false when a polygon vertex is on the boundary edge
+	bool push_crossings(crossing_container_type &crossings, const polygon_type &polygon, size_t boundary_edge, bool source_inside) const {
+		const point_type &source = boundary[boundary_edge];
+		const point_type &target = boundary[get_next_index(boundary, boundary_edge)];
+		std::vector<CGAL::Orientation> orientations(polygon.size());
+		for(size_t polygon_vertex = 0; polygon_vertex < polygon.size(); ++polygon_vertex) {
+			orientations[polygon_vertex] = CGAL::orientation(source, target, polygon[polygon_vertex]);
+			if(orientations[polygon_vertex] == CGAL::COLLINEAR && CGAL::collinear_are_ordered_along_line(source, polygon[polygon_vertex], target))
+				return false;
+		}
+		size_t first_crossing = crossings.size();
+		for(size_t polygon_edge = 0; polygon_edge < polygon.size(); ++polygon_edge) {
+			size_t next_polygon_vertex = get_next_index(polygon, polygon_edge);
+			if(orientations[polygon_edge] == CGAL::COLLINEAR || orientations[next_polygon_vertex] == CGAL::COLLINEAR || orientations[polygon_edge] == orientations[next_polygon_vertex])
+				continue;
+			const point_type &polygon_source = polygon[polygon_edge];
+			const point_type &polygon_target = polygon[next_polygon_vertex];
+			CGAL::Orientation source_orientation = CGAL::orientation(polygon_source, polygon_target, source);
+			CGAL::Orientation target_orientation = CGAL::orientation(polygon_source, polygon_target, target);
+			if(source_orientation == CGAL::COLLINEAR || target_orientation == CGAL::COLLINEAR || source_orientation == target_orientation)
+				continue;
+			crossings.push_back(crossing{boundary_edge, polygon_edge, get_crossing_point(source, target, polygon_source, polygon_target), false});
+		}
+		// a convex polygon is crossed at most twice by a segment
+		if(crossings.size() - first_crossing > 2)
+			return false;
+		if(crossings.size() - first_crossing == 2 && CGAL::compare_distance_to_point(source, crossings[first_crossing].point, crossings[first_crossing + 1].point) == CGAL::LARGER)
+			std::swap(crossings[first_crossing], crossings[first_crossing + 1]);
+		for(size_t index = first_crossing; index < crossings.size(); ++index) {
+			crossings[index].entry = !source_inside;
+			source_inside = !source_inside;
+		}
+		return true;
+	}
+
+	static point_type get_crossing_point(const point_type &source, const point_type &target, const point_type &polygon_source, const point_type &polygon_target) {
+		auto intersection = CGAL::intersection(line_type(source, target), line_type(polygon_source, polygon_target));
+		UTIL_ASSERT(intersection);
+		return *boost::get<point_type>(&*intersection);
+	}
+
+	// the crossings sorted counterclockwise along the polygon boundary
+	static index_container_type get_polygon_order(const polygon_type &polygon, const crossing_container_type &crossings) {
+		index_container_type order(crossings.size());
+		for(size_t index = 0; index < order.size(); ++index)
+			order[index] = index;
+		std::sort(order.begin(), order.end(), [&polygon, &crossings](size_t index1, size_t index2) {
+			const crossing &crossing1 = crossings[index1];
+			const crossing &crossing2 = crossings[index2];
+			if(crossing1.polygon_edge != crossing2.polygon_edge)
+				return crossing1.polygon_edge < crossing2.polygon_edge;
+			return CGAL::compare_distance_to_point(polygon[crossing1.polygon_edge], crossing1.point, crossing2.point) == CGAL::SMALLER;
+		});
+		return order;
+	}
+
+	// pushes the vertices of **ring** from the edge **first_edge** to the edge **last_edge**, all around when **wrap**
+	template <class Ring> static void push_vertices(point_container_type &points, const Ring &ring, size_t first_edge, size_t last_edge, bool wrap) {
+		if(first_edge == last_edge && !wrap)
+			return;
+		size_t edge = first_edge;
+		do {
+			edge = get_next_index(ring, edge);
+			points.push_back(ring[edge]);
+		} while(edge != last_edge);
+	}
+
+	// the crossings are sorted along the boundary and alternate entries and exits, each exit is followed on the polygon by an entry
+	result_type get_clipped_polygon(const polygon_type &polygon, const point_type &point, const crossing_container_type &crossings) const {
+		index_container_type polygon_order = get_polygon_order(polygon, crossings);
+		index_container_type polygon_positions(crossings.size());
+		for(size_t position = 0; position < polygon_order.size(); ++position)
+			polygon_positions[polygon_order[position]] = position;
+		std::vector<bool> visited(crossings.size(), false);
+		for(size_t start = 0; start < crossings.size(); ++start) {
+			if(visited[start] || !crossings[start].entry)
+				continue;
+			point_container_type points;
+			size_t entry = start;
+			do {
+				size_t exit = get_next_index(crossings, entry);
+				if(crossings[exit].entry || visited[entry])
+					return result_type();
+				visited[entry] = visited[exit] = true;
+				points.push_back(crossings[entry].point);
+				push_vertices(points, boundary, crossings[entry].boundary_edge, crossings[exit].boundary_edge, exit <= entry);
+				points.push_back(crossings[exit].point);
+				size_t exit_position = polygon_positions[exit];
+				size_t entry_position = get_next_index(polygon_order, exit_position);
+				entry = polygon_order[entry_position];
+				if(!crossings[entry].entry)
+					return result_type();
+				push_vertices(points, polygon, crossings[exit].polygon_edge, crossings[entry].polygon_edge, entry_position <= exit_position);
+			} while(entry != start);
+			polygon_type clipped_polygon(points.begin(), points.end());
+			if(clipped_polygon.bounded_side(point) != CGAL::ON_UNBOUNDED_SIDE)
+				return clipped_polygon;
+		}
+		return result_type();
+	}
+};
+
+} // namespace geofis
+
+#endif /* CONVEX_POLYGON_CLIPPER_HPP_ */
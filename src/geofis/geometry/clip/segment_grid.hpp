@@ -0,0 +1,138 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef SEGMENT_GRID_HPP_
+#define SEGMENT_GRID_HPP_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <CGAL/Bbox_2.h>
+
+namespace geofis {
+
+/*
+@startuml
+
+title segment grid class diagram
+
+class segment_grid {
+	- bbox : Bbox_2
+	- segment_bboxes : Bbox_2 [0..*]
+	- cells : size_t [0..*] [0..*]
+	+ segment_grid(segments: Segment_2 [0..*])
+	+ get_segments(bbox: Bbox_2, segment_indexes: size_t [0..*])
+}
+
+note right of segment_grid
+	uniform grid of about one cell per segment over the bounding box of the segments,
+	each cell keeps the indexes of the segments whose bounding box overlaps it
+end note
+
+@enduml
+*/
+
+class segment_grid {
+
+	typedef std::vector<size_t> index_container_type;
+
+public:
+	segment_grid() : column_count(0), row_count(0), cell_width(0), cell_height(0) {}
+
+	template <class SegmentRange> segment_grid(const SegmentRange &segments) {
+		for(const auto &segment : segments)
+			segment_bboxes.push_back(segment.bbox());
+		initialize_cells();
+	}
+
+	//! fills **segment_indexes** with the sorted indexes of the segments whose bounding box overlaps **query_bbox**
+	void get_segments(const CGAL::Bbox_2 &query_bbox, index_container_type &segment_indexes) const {
+		segment_indexes.clear();
+		if(segment_bboxes.empty() || !CGAL::do_overlap(bbox, query_bbox))
+			return;
+		for(size_t row = get_row(query_bbox.ymin()); row <= get_row(query_bbox.ymax()); ++row)
+			for(size_t column = get_column(query_bbox.xmin()); column <= get_column(query_bbox.xmax()); ++column)
+				for(size_t segment_index : cells[row * column_count + column])
+					if(CGAL::do_overlap(segment_bboxes[segment_index], query_bbox))
+						segment_indexes.push_back(segment_index);
+		std::sort(segment_indexes.begin(), segment_indexes.end());
+		segment_indexes.erase(std::unique(segment_indexes.begin(), segment_indexes.end()), segment_indexes.end());
+	}
+
+private:
+	CGAL::Bbox_2 bbox;
+	std::vector<CGAL::Bbox_2> segment_bboxes;
+	size_t column_count;
+	size_t row_count;
+	double cell_width;
+	double cell_height;
+	std::vector<index_container_type> cells;
+
+	void initialize_cells() {
+		for(const CGAL::Bbox_2 &segment_bbox : segment_bboxes)
+			bbox += segment_bbox;
+		column_count = row_count = std::max<size_t>(1, std::ceil(std::sqrt(segment_bboxes.size())));
+		cell_width = (bbox.xmax() - bbox.xmin()) / column_count;
+		cell_height = (bbox.ymax() - bbox.ymin()) / row_count;
+		cells.resize(column_count * row_count);
+		for(size_t segment_index = 0; segment_index < segment_bboxes.size(); ++segment_index) {
+			const CGAL::Bbox_2 &segment_bbox = segment_bboxes[segment_index];
+			for(size_t row = get_row(segment_bbox.ymin()); row <= get_row(segment_bbox.ymax()); ++row)
+				for(size_t column = get_column(segment_bbox.xmin()); column <= get_column(segment_bbox.xmax()); ++column)
+					cells[row * column_count + column].push_back(segment_index);
+		}
+	}
+
+	static size_t get_cell(double coordinate, double minimum, double cell_size, size_t cell_count) {
+		if(cell_size <= 0 || coordinate <= minimum)
+			return 0;
+		return std::min<size_t>(cell_count - 1, (coordinate - minimum) / cell_size);
+	}
+
+	size_t get_column(double x) const {
+		return get_cell(x, bbox.xmin(), cell_width, column_count);
+	}
+
+	size_t get_row(double y) const {
+		return get_cell(y, bbox.ymin(), cell_height, row_count);
+	}
+};
+
+} // namespace geofis
+
+#endif /* SEGMENT_GRID_HPP_ */
@@ -0,0 +1,334 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H199AD3C4_CB50_4384_B682_898C05AB8003
+#define H199AD3C4_CB50_4384_B682_898C05AB8003
+
+#include <map>
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/next_prior.hpp>
+#include <boost/functional/hash.hpp>
+#include <CGAL/Point_2.h>
+#include <CGAL/Direction_2.h>
+#include <CGAL/Polygon_2.h>
+#include <CGAL/Polygon_with_holes_2.h>
+#include <CGAL/Boolean_set_operations_2.h>
+
+namespace geofis {
+
+/*
+@startuml
+
+title halfedge dissolve class diagram
+
+class halfedge_dissolve<Kernel> {
+	- vertices : Point_2 [0..*]
+	- halfedges : (size_t, size_t) [0..*]
+	+ add(polygon: Polygon_2)
+	+ add(polygon_with_holes: Polygon_with_holes_2)
+	+ subtract(polygon_with_holes: Polygon_with_holes_2)
+	+ dissolve(dissolve_result: Polygon_with_holes_2) : bool
+}
+
+note right of halfedge_dissolve
+	the voronoi polygons tile the border, two neighbor polygons share the same vertices
+	on their common edges, and the geometries dissolved from them keep these vertices:
+	each oriented edge of a polygon is a halfedge, the zone on its left side,
+	a halfedge added while its twin is indexed is an inner edge, both are removed,
+	the remaining halfedges are the boundary of the union, without any arrangement
+end note
+
+note bottom of halfedge_dissolve
+	the boundary halfedges are linked in rings with the rightmost turn at each vertex,
+	so the outer boundary touching itself at a vertex is a single counterclockwise ring,
+	and the holes touching the outer boundary or another hole at a vertex are
+	separate clockwise rings, as CGAL::join:
+	the outer boundary starts at its lexicographically smallest vertex,
+	each hole starts at its lexicographically largest vertex,
+	the holes are sorted by their lexicographically smallest vertex
+end note
+
+@enduml
+*/
+
+template <class Kernel> class halfedge_dissolve {
+
+	typedef CGAL::Point_2<Kernel> point_type;
+	typedef CGAL::Direction_2<Kernel> direction_type;
+	typedef CGAL::Polygon_2<Kernel> polygon_type;
+	typedef CGAL::Polygon_with_holes_2<Kernel> polygon_with_holes_type;
+	typedef std::vector<point_type> vertex_container_type;
+	typedef std::map<point_type, size_t> vertex_index_container_type;
+	typedef std::pair<size_t, size_t> halfedge_type;
+	typedef std::unordered_set<halfedge_type, boost::hash<halfedge_type> > halfedge_container_type;
+	typedef std::unordered_map<size_t, std::vector<size_t> > target_container_type;
+	typedef std::vector<size_t> ring_type;
+	typedef std::vector<ring_type> ring_container_type;
+
+public:
+	halfedge_dissolve() : valid(true) {}
+
+	//! adds the halfedges of the counterclockwise **polygon**
+	void add(const polygon_type &polygon) {
+		add_ring(polygon, false);
+	}
+
+	//! adds the halfedges of **polygon_with_holes**, oriented as the boolean set operations require
+	void add(const polygon_with_holes_type &polygon_with_holes) {
+		add_ring(polygon_with_holes.outer_boundary(), false);
+		for(typename polygon_with_holes_type::Hole_const_iterator hole = polygon_with_holes.holes_begin(); hole != polygon_with_holes.holes_end(); ++hole)
+			add_ring(*hole, false);
+	}
+
+	//! adds the twins of the halfedges of **polygon_with_holes**, which must be inside the added polygons
+	void subtract(const polygon_with_holes_type &polygon_with_holes) {
+		add_ring(polygon_with_holes.outer_boundary(), true);
+		for(typename polygon_with_holes_type::Hole_const_iterator hole = polygon_with_holes.holes_begin(); hole != polygon_with_holes.holes_end(); ++hole)
+			add_ring(*hole, true);
+	}
+
+	//! links the remaining halfedges in **dissolve_result**, returns false when they do not bound a single polygon with holes
+	bool dissolve(polygon_with_holes_type &dissolve_result) const {
+		ring_container_type rings;
+		if(!valid || !link_rings(rings))
+			return false;
+		ring_container_type outer_rings;
+		ring_container_type hole_rings;
+		for(ring_type &ring : rings) {
+			switch(get_orientation(ring)) {
+			case CGAL::COUNTERCLOCKWISE:
+				outer_rings.push_back(std::move(ring));
+				break;
+			case CGAL::CLOCKWISE:
+				hole_rings.push_back(std::move(ring));
+				break;
+			default:
+				return false;
+			}
+		}
+		// the outer rings not touching the others are other polygons
+		if(outer_rings.size() != 1)
+			return false;
+		ring_type &outer_ring = outer_rings.front();
+		std::rotate(outer_ring.begin(), get_smallest_vertex(outer_ring), outer_ring.end());
+		std::sort(hole_rings.begin(), hole_rings.end(), [this](const ring_type &ring1, const ring_type &ring2) { return is_less_vertex(*get_smallest_vertex(ring1), *get_smallest_vertex(ring2)); });
+		dissolve_result = polygon_with_holes_type(make_polygon(outer_ring));
+		for(ring_type &hole_ring : hole_rings) {
+			std::rotate(hole_ring.begin(), get_largest_vertex(hole_ring), hole_ring.end());
+			dissolve_result.add_hole(make_polygon(hole_ring));
+		}
+		return true;
+	}
+
+private:
+	vertex_container_type vertices;
+	vertex_index_container_type vertex_indexes;
+	halfedge_container_type halfedges;
+	bool valid;
+
+	// the same vertex built by different constructions is found by exact comparison
+	size_t get_vertex(const point_type &point) {
+		typename vertex_index_container_type::iterator vertex_index = vertex_indexes.lower_bound(point);
+		if(vertex_index != vertex_indexes.end() && vertex_index->first == point)
+			return vertex_index->second;
+		vertices.push_back(point);
+		vertex_indexes.emplace_hint(vertex_index, point, vertices.size() - 1);
+		return vertices.size() - 1;
+	}
+
+	void add_ring(const polygon_type &ring, bool twin) {
+		if(ring.size() < 3)
+			return;
+		size_t first_vertex = get_vertex(*ring.vertices_begin());
+		size_t source_vertex = first_vertex;
+		for(typename polygon_type::Vertex_const_iterator vertex = boost::next(ring.vertices_begin()); vertex != ring.vertices_end(); ++vertex) {
+			size_t target_vertex = get_vertex(*vertex);
+			add_halfedge(source_vertex, target_vertex, twin);
+			source_vertex = target_vertex;
+		}
+		add_halfedge(source_vertex, first_vertex, twin);
+	}
+
+	void add_halfedge(size_t source_vertex, size_t target_vertex, bool twin) {
+		// the degenerated voronoi edges are removed, their vertices are the same
+		if(source_vertex == target_vertex)
+			return;
+		halfedge_type halfedge = twin ? halfedge_type(target_vertex, source_vertex) : halfedge_type(source_vertex, target_vertex);
+		if(halfedges.erase(halfedge_type(halfedge.second, halfedge.first)))
+			return;
+		// an overlap of the polygons
+		if(!halfedges.insert(halfedge).second)
+			valid = false;
+	}
+
+	bool link_rings(ring_container_type &rings) const {
+		target_container_type targets;
+		for(const halfedge_type &halfedge : halfedges)
+			targets[halfedge.first].push_back(halfedge.second);
+		halfedge_container_type linked_halfedges;
+		for(const halfedge_type &halfedge : halfedges) {
+			if(linked_halfedges.count(halfedge))
+				continue;
+			ring_type ring;
+			halfedge_type ring_halfedge = halfedge;
+			do {
+				// two halfedges are linked to the same halfedge, the boundary is not valid
+				if(!linked_halfedges.insert(ring_halfedge).second)
+					return false;
+				ring.push_back(ring_halfedge.first);
+				ring_halfedge = halfedge_type(ring_halfedge.second, get_next_target(targets, ring_halfedge));
+			} while(ring_halfedge != halfedge);
+			rings.push_back(std::move(ring));
+		}
+		return true;
+	}
+
+	// the first target counterclockwise from the source of **halfedge**, around its target
+	size_t get_next_target(const target_container_type &targets, const halfedge_type &halfedge) const {
+		const std::vector<size_t> &vertex_targets = targets.find(halfedge.second)->second;
+		if(vertex_targets.size() == 1)
+			return vertex_targets.front();
+		const point_type &vertex = vertices[halfedge.second];
+		direction_type source_direction(vertices[halfedge.first] - vertex);
+		size_t next_target = vertex_targets.front();
+		direction_type next_direction(vertices[next_target] - vertex);
+		for(size_t vertex_target : vertex_targets) {
+			direction_type target_direction(vertices[vertex_target] - vertex);
+			if(is_counterclockwise_before(source_direction, target_direction, next_direction)) {
+				next_target = vertex_target;
+				next_direction = target_direction;
+			}
+		}
+		return next_target;
+	}
+
+	static bool is_counterclockwise_before(const direction_type &reference, const direction_type &direction1, const direction_type &direction2) {
+		if(direction1 == reference || direction1 == direction2)
+			return false;
+		if(direction2 == reference)
+			return true;
+		return direction1.counterclockwise_in_between(reference, direction2);
+	}
+
+	bool is_less_vertex(size_t vertex1, size_t vertex2) const {
+		return CGAL::compare_xy(vertices[vertex1], vertices[vertex2]) == CGAL::SMALLER;
+	}
+
+	typename ring_type::iterator get_smallest_vertex(ring_type &ring) const {
+		return std::min_element(ring.begin(), ring.end(), [this](size_t vertex1, size_t vertex2) { return is_less_vertex(vertex1, vertex2); });
+	}
+
+	typename ring_type::const_iterator get_smallest_vertex(const ring_type &ring) const {
+		return std::min_element(ring.begin(), ring.end(), [this](size_t vertex1, size_t vertex2) { return is_less_vertex(vertex1, vertex2); });
+	}
+
+	typename ring_type::iterator get_largest_vertex(ring_type &ring) const {
+		return std::max_element(ring.begin(), ring.end(), [this](size_t vertex1, size_t vertex2) { return is_less_vertex(vertex1, vertex2); });
+	}
+
+	// the smallest vertex of a simple ring is convex, the orientation of its corner is the orientation of the ring
+	CGAL::Orientation get_orientation(const ring_type &ring) const {
+		if(ring.size() < 3)
+			return CGAL::COLLINEAR;
+		typename ring_type::const_iterator vertex = get_smallest_vertex(ring);
+		size_t previous_vertex = vertex == ring.begin() ? ring.back() : *boost::prior(vertex);
+		size_t next_vertex = boost::next(vertex) == ring.end() ? ring.front() : *boost::next(vertex);
+		return CGAL::orientation(vertices[previous_vertex], vertices[*vertex], vertices[next_vertex]);
+	}
+
+	polygon_type make_polygon(const ring_type &ring) const {
+		polygon_type polygon;
+		for(size_t vertex : ring)
+			polygon.push_back(vertices[vertex]);
+		return polygon;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//! dissolves the polygons of **geometries** in **dissolve_result**, returns false when they do not form a single polygon with holes
+template <class GeometryRange, class Kernel> bool dissolve_geometries(const GeometryRange &geometries, CGAL::Polygon_with_holes_2<Kernel> &dissolve_result) {
+	halfedge_dissolve<Kernel> dissolve;
+	for(const auto &geometry : geometries)
+		dissolve.add(geometry);
+	return dissolve.dissolve(dissolve_result);
+}
+
+//! dissolves **geometry1** and **geometry2** in **dissolve_result**, returns false when they do not form a single polygon with holes
+template <class Kernel> bool dissolve_geometries(const CGAL::Polygon_with_holes_2<Kernel> &geometry1, const CGAL::Polygon_with_holes_2<Kernel> &geometry2, CGAL::Polygon_with_holes_2<Kernel> &dissolve_result) {
+	halfedge_dissolve<Kernel> dissolve;
+	dissolve.add(geometry1);
+	dissolve.add(geometry2);
+	return dissolve.dissolve(dissolve_result);
+}
+
+//! removes **geometry2** from **geometry1**, which contains it, in **difference_result**, returns false when the difference is not a single polygon with holes
+template <class Kernel> bool dissolve_difference(const CGAL::Polygon_with_holes_2<Kernel> &geometry1, const CGAL::Polygon_with_holes_2<Kernel> &geometry2, CGAL::Polygon_with_holes_2<Kernel> &difference_result) {
+	halfedge_dissolve<Kernel> dissolve;
+	dissolve.add(geometry1);
+	dissolve.subtract(geometry2);
+	return dissolve.dissolve(difference_result);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//! joins **geometry1** and **geometry2** in **join_result**, with CGAL::join when the dissolve fails, returns false when they do not form a single polygon with holes
+template <class Kernel> bool join_geometries(const CGAL::Polygon_with_holes_2<Kernel> &geometry1, const CGAL::Polygon_with_holes_2<Kernel> &geometry2, CGAL::Polygon_with_holes_2<Kernel> &join_result) {
+	return dissolve_geometries(geometry1, geometry2, join_result) || CGAL::join(geometry1, geometry2, join_result);
+}
+
+//! removes **geometry2** from **geometry1** in **difference_result**, with CGAL::difference when the dissolve fails, returns false when the difference is not a single polygon with holes
+template <class Kernel> bool difference_geometries(const CGAL::Polygon_with_holes_2<Kernel> &geometry1, const CGAL::Polygon_with_holes_2<Kernel> &geometry2, CGAL::Polygon_with_holes_2<Kernel> &difference_result) {
+	if(dissolve_difference(geometry1, geometry2, difference_result))
+		return true;
+	std::vector<CGAL::Polygon_with_holes_2<Kernel> > difference_results;
+	CGAL::difference(geometry1, geometry2, std::back_inserter(difference_results));
+	if(difference_results.size() != 1)
+		return false;
+	difference_result = difference_results.front();
+	return true;
+}
+
+} // namespace geofis
+
+#endif // H199AD3C4_CB50_4384_B682_898C05AB8003
@@ -0,0 +1,78 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H611E4E0F_7665_4397_A403_E9A3DC977C5E
+#define H611E4E0F_7665_4397_A403_E9A3DC977C5E
+
+#include <CGAL/Point_2.h>
+#include <CGAL/Polygon_2.h>
+#include <CGAL/Polygon_with_holes_2.h>
+#include <CGAL/number_utils.h>
+
+namespace geofis {
+
+/*
+ * The lazy numbers of the exact constructions kernel share their representations between the copies of a geometry,
+ * and their reference counts are not atomic: a geometry is copied by make_unshared_geometry before it is used in
+ * another thread, then the copy and the geometries built from it must stay in that thread until it is joined.
+ */
+
+template <class Kernel> inline CGAL::Point_2<Kernel> make_unshared_geometry(const CGAL::Point_2<Kernel> &point) {
+
+	typedef typename Kernel::FT ft_type;
+
+	return CGAL::Point_2<Kernel>(ft_type(CGAL::exact(point.x())), ft_type(CGAL::exact(point.y())));
+}
+
+template <class Kernel> inline CGAL::Polygon_2<Kernel> make_unshared_geometry(const CGAL::Polygon_2<Kernel> &polygon) {
+	CGAL::Polygon_2<Kernel> unshared_polygon;
+	for(typename CGAL::Polygon_2<Kernel>::Vertex_const_iterator vertex = polygon.vertices_begin(); vertex != polygon.vertices_end(); ++vertex)
+		unshared_polygon.push_back(make_unshared_geometry(*vertex));
+	return unshared_polygon;
+}
+
+template <class Kernel> inline CGAL::Polygon_with_holes_2<Kernel> make_unshared_geometry(const CGAL::Polygon_with_holes_2<Kernel> &polygon_with_holes) {
+	CGAL::Polygon_with_holes_2<Kernel> unshared_polygon_with_holes(make_unshared_geometry(polygon_with_holes.outer_boundary()));
+	for(typename CGAL::Polygon_with_holes_2<Kernel>::Hole_const_iterator hole = polygon_with_holes.holes_begin(); hole != polygon_with_holes.holes_end(); ++hole)
+		unshared_polygon_with_holes.add_hole(make_unshared_geometry(*hole));
+	return unshared_polygon_with_holes;
+}
+
+} // namespace geofis
+
+#endif // H611E4E0F_7665_4397_A403_E9A3DC977C5E
@@ -45,7 +45,7 @@ namespace geofis {
 
 fusion_process::fusion_process() : impl(nullptr) {}
 
-fusion_process::fusion_process(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors) : impl(new fusion_process_impl(aggregation, zone_distance, multidimensional_distance, attribute_distances, features, zone_neighbors)) {}
+fusion_process::fusion_process(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t minimum_zone_count) : impl(fusion_process_impl::make_fusion_process_impl(aggregation, zone_distance, multidimensional_distance, attribute_distances, features, zone_neighbors, thread_count, sampling, minimum_zone_count)) {}
 
 fusion_process::~fusion_process() {}
 
@@ -62,4 +62,16 @@ fusion_process::fusion_map_range_type fusion_process::get_fusion_maps(zone_info_
 	return impl->get_fusion_maps(zones, begin, end, compute_zones);
 }
 
+fusion_process::fusion_dendrogram_type fusion_process::get_fusion_dendrogram(const zone_info_policy_type &zones) const {
+	return impl->get_fusion_dendrogram(zones);
+}
+
+void fusion_process::compute_zone_geometries(const fusion_map_type &fusion_map, size_t thread_count) {
+	impl->compute_zone_geometries(fusion_map, thread_count);
+}
+
+size_t fusion_process::get_zone_geometry_vertex_size() const {
+	return impl->get_zone_geometry_vertex_size();
+}
+
 } // namespace geofis
@@ -50,12 +50,15 @@ class fusion_process {
 
 	typedef fusion_process_traits::aggregation_type aggregation_type;
 	typedef fusion_process_traits::zone_distance_type zone_distance_type;
+	typedef fusion_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
 	typedef fusion_process_traits::multidimensional_distance_type multidimensional_distance_type;
 	typedef fusion_process_traits::attribute_distance_range_type attribute_distance_range_type;
 	typedef fusion_process_traits::feature_range_type feature_range_type;
 	typedef fusion_process_traits::zone_neighbor_range_type zone_neighbor_range_type;
 	typedef fusion_process_traits::zone_info_policy_type zone_info_policy_type;
+	typedef fusion_process_traits::fusion_map_type fusion_map_type;
 	typedef fusion_process_traits::fusion_map_range_type fusion_map_range_type;
+	typedef fusion_process_traits::fusion_dendrogram_type fusion_dendrogram_type;
 
 	BOOST_MOVABLE_BUT_NOT_COPYABLE(fusion_process)
 
@@ -63,7 +66,7 @@ class fusion_process {
 
 public:
 	fusion_process();
-	fusion_process(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors);
+	fusion_process(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors, size_t thread_count = 1, const feature_distance_sampling_type &sampling = feature_distance_sampling_type(), size_t minimum_zone_count = 1);
 	~fusion_process();
 
 	fusion_process & operator= (BOOST_RV_REF(fusion_process) other) {
@@ -73,6 +76,9 @@ public:
 
 	size_t get_fusion_size() const;
 	fusion_map_range_type get_fusion_maps(zone_info_policy_type &zones, size_t begin, size_t end, bool compute_zones = false);
+	fusion_dendrogram_type get_fusion_dendrogram(const zone_info_policy_type &zones) const;
+	void compute_zone_geometries(const fusion_map_type &fusion_map, size_t thread_count = 1);
+	size_t get_zone_geometry_vertex_size() const;
 
 	bool is_implemented() const {
 		return impl;
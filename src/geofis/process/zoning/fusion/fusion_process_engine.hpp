@@ -0,0 +1,309 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef H84CDA6C0_2A85_4DE7_A5EC_153A877805C7
+#define H84CDA6C0_2A85_4DE7_A5EC_153A877805C7
+
+#include <list>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/range/algorithm/transform.hpp>
+#include <boost/next_prior.hpp>
+#include <boost/range/algorithm/stable_sort.hpp>
+#include <util/double.h>
+#include <util/algorithm/parallel_for_each_chunk.hpp>
+#include <geofis/process/zoning/fusion/fusion_process_impl.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_distance.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_queue.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_adjacency.hpp>
+#include <geofis/algorithm/zoning/fusion/aggregation/aggregation_adaptor.hpp>
+#include <geofis/algorithm/zoning/fusion/neighbor_to_zone_pair.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_distance_updater.hpp>
+#include <geofis/algorithm/zoning/pair/ward_zone_pair_distance_updater.hpp>
+#include <geofis/algorithm/zoning/pair/zone_pair_updater.hpp>
+
+namespace geofis {
+
+/*
+@startuml
+
+title fusion_process_engine class diagram
+
+class fusion_process_impl {
+	- zone_fusions : zone_fusion [0..*]
+	- zone_geometry_cache : zone_geometry_cache [0..1]
+	+ get_fusion_size() : size_t
+	+ get_fusion_maps(zones: zone_info_policy, begin: size_t, end: size_t, compute_zones: bool) : fusion_map_range
+	+ compute_zone_geometries(fusion_map: fusion_map, thread_count: size_t)
+	+ get_zone_geometry_vertex_size() : size_t
+}
+
+class fusion_process_engine<ZoneDistance, FeatureDistance> {
+	- aggregation : aggregation
+	- feature_distance : FeatureDistance
+	- zone_pairs : zone_pair<ZoneDistance> [0..*]
+	- fusion_size_limit : size_t
+}
+
+fusion_process_impl <|-- fusion_process_engine
+
+note right of fusion_process_engine
+	**ZoneDistance** and **FeatureDistance** are the concrete
+	types held by the variant distances of the zoning process,
+	they are selected once by make_fusion_process_impl
+	so the zone pair distances are computed without variant dispatch
+end note
+
+@enduml
+*/
+
+template <class ZoneDistance, class FeatureDistance> class fusion_process_engine : public fusion_process_impl {
+
+	typedef fusion_process_traits::aggregation_type aggregation_type;
+	typedef fusion_process_traits::zone_neighbor_range_type zone_neighbor_range_type;
+	typedef fusion_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
+
+	typedef aggregation_adaptor<aggregation_type> aggregation_adaptor_type;
+
+	typedef zone_pair_distance<ZoneDistance> zone_pair_distance_type;
+	typedef fusion_process_traits::zone_type zone_type;
+	typedef zone_pair<zone_type, zone_pair_distance_type> zone_pair_type;
+	typedef std::list<zone_pair_type> zone_pair_container_type;
+	typedef typename boost::range_iterator<zone_pair_container_type>::type zone_pair_iterator_type;
+	typedef std::list<zone_pair_iterator_type> zone_pair_iterator_container_type;
+	typedef geofis::zone_pair_queue<zone_pair_iterator_type> zone_pair_queue_type;
+	typedef geofis::zone_pair_adjacency<zone_pair_iterator_type> zone_pair_adjacency_type;
+	typedef neighbor_to_zone_pair<zone_type, ZoneDistance, FeatureDistance> neighbor_to_zone_pair_type;
+
+	typedef typename zone_pair_distance_updater_traits<ZoneDistance, FeatureDistance>::type zone_pair_distance_updater_type;
+	typedef zone_pair_updater<zone_pair_distance_updater_type> zone_pair_updater_type;
+
+	typedef typename boost::range_iterator<zone_fusion_container_type>::type zone_fusion_iterator_type;
+	typedef std::pair<double, zone_fusion_iterator_type> zone_fusion_height_type;
+	typedef std::unordered_map<const zone_type *, double> zone_height_container_type;
+
+	aggregation_adaptor_type aggregation;
+	FeatureDistance feature_distance;
+	zone_pair_container_type zone_pairs;
+	zone_pair_queue_type zone_pair_queue;
+	zone_pair_adjacency_type zone_pair_adjacency;
+	std::vector<zone_fusion_height_type> zone_fusion_heights;
+	zone_height_container_type zone_heights;
+	size_t fusion_size_limit;
+
+public:
+	fusion_process_engine(const aggregation_type &aggregation, const ZoneDistance &zone_distance, const FeatureDistance &feature_distance, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t fusion_size_limit) : aggregation(aggregation), feature_distance(feature_distance), fusion_size_limit(fusion_size_limit) {
+		initialize_zone_pairs_with_neighbors(zone_distance, zone_neighbors, thread_count);
+		aggregate_zone_pairs(zone_pair_updater_type(zone_pair_distance_updater_type(this->feature_distance, thread_count, sampling)));
+	}
+
+private:
+	// each chunk of **zone_neighbors** is transformed in its own **zone_pairs** chunk
+	struct zone_pair_chunk_initializer {
+
+		zone_pair_chunk_initializer(const neighbor_to_zone_pair_type &neighbor_to_zone_pair, zone_neighbor_range_type &zone_neighbors, std::vector<zone_pair_container_type> &zone_pair_chunks) : neighbor_to_zone_pair(neighbor_to_zone_pair), zone_neighbors(zone_neighbors), zone_pair_chunks(zone_pair_chunks) {}
+
+		void operator()(size_t chunk, size_t begin, size_t end) const {
+			boost::transform(boost::make_iterator_range(boost::begin(zone_neighbors) + begin, boost::begin(zone_neighbors) + end), std::back_inserter(zone_pair_chunks[chunk]), neighbor_to_zone_pair);
+		}
+
+		const neighbor_to_zone_pair_type &neighbor_to_zone_pair;
+		zone_neighbor_range_type &zone_neighbors;
+		std::vector<zone_pair_container_type> &zone_pair_chunks;
+	};
+
+	// the zone pair chunks are spliced in **zone_neighbors** order, so **zone_pairs** does not depend on **thread_count**
+	void initialize_zone_pairs_with_neighbors(const ZoneDistance &zone_distance, zone_neighbor_range_type &zone_neighbors, size_t thread_count) {
+		size_t zone_neighbor_size = boost::size(zone_neighbors);
+		std::vector<zone_pair_container_type> zone_pair_chunks(util::get_chunk_count(zone_neighbor_size, thread_count));
+		util::parallel_for_each_chunk(zone_neighbor_size, thread_count, zone_pair_chunk_initializer(neighbor_to_zone_pair_type(zone_distance, feature_distance), zone_neighbors, zone_pair_chunks));
+		for(zone_pair_container_type &zone_pair_chunk : zone_pair_chunks)
+			zone_pairs.splice(boost::end(zone_pairs), zone_pair_chunk);
+	}
+
+	/**
+	@startuml
+
+	title aggregate_zone_pairs activity diagram\n
+
+	start
+
+	floating note left: In this diagram **zone_pair** and **zone_pair_to_merge** are an iterator type.
+
+	:transform **zone_neighbors** to **zone_pairs**;
+	note right
+		the transformation is split
+		on **thread_count** threads
+	end note
+	:sort **zone_pairs** by id comparator;
+	note right
+		this guarantees algorithm reproducibility
+		CGAL delaunay triangulation is not reproducible
+		so **zone_neighbors** are not ordered
+
+		**zone_pairs** is std::list<zone_pair>
+		this guarantees iterator validity on remove operation
+	end note
+
+	:push all **zone_pair** in **zone_pair_queue**;
+	note right
+		**zone_pair_queue** is an addressable min heap
+		in merging order, ties are broken with the
+		distance history then with the id comparator
+	end note
+	:add all **zone_pair** in **zone_pair_adjacency**;
+	note right
+		**zone_pair_adjacency** index the **zone_pairs**
+		incident to each zone
+	end note
+
+	while(**zone_pair_queue** empty or **fusion_size_limit** reached ?) is (false)
+		:copy the **zone_pairs** to merge in **zone_pairs_to_merge**
+		according the **aggregation** function;
+		note right
+			minimum_aggregation copies the top **zone_pair**
+			reciprocal_nearest_aggregation copies all the
+			disjoint reciprocal nearest **zone_pairs**
+		end note
+
+		while (for each **zone_pair_to_merge** in **zone_pairs_to_merge** until **fusion_size_limit** is reached)
+			:build **zone_fusion** with **zone_pair_to_merge**
+			copy **zone_fusion** in **zone_fusions**;
+
+			:remove **zone_pair_to_merge** in **zone_pair_queue**
+			remove **zone_pair_to_merge** in **zone_pair_adjacency**
+			remove **zone_pair_to_merge** in **zone_pairs**;
+
+			:update incident **zone_pairs**, **zone_pair_queue** and **zone_pair_adjacency**
+			according **zone_pair_updater** and **zone_fusion**;
+			note right
+				the distances of the updated **zone_pairs**
+				are computed on **thread_count** threads,
+				on samples of the zone features when the
+				cross product is larger than the **sampling** size
+			end note
+		end while
+	end while (true)
+
+	if (several **zone_pairs** merged in a round ?) then (yes)
+		:stable sort **zone_fusions** by fusion height;
+		note right
+			a zone created in a round can be merged in a later round
+			at a lower distance than another fusion of the first round
+
+			the fusion height is the fusion distance, raised to the
+			height of the fusions of its zones: the zone pair distances
+			are compared with a tolerance, so a fusion distance can be
+			slightly lower than the fusion distance of one of its zones
+		end note
+	endif
+
+	end
+
+	@enduml
+	*/
+	void aggregate_zone_pairs(const zone_pair_updater_type &zone_pair_updater) {
+		zone_pairs.sort(zone_pair_id_comparator());
+		for(zone_pair_iterator_type zone_pair = boost::begin(zone_pairs); zone_pair != boost::end(zone_pairs); ++zone_pair) {
+			zone_pair_queue.push(zone_pair);
+			zone_pair_adjacency.add(zone_pair);
+		}
+		bool batch = false;
+		while(!zone_pair_queue.empty() && !is_fusion_size_limit_reached()) {
+			zone_pair_iterator_container_type zone_pairs_to_merge;
+			aggregation(zone_pair_queue, std::back_inserter(zone_pairs_to_merge));
+			for(zone_pair_iterator_type zone_pair_to_merge : zone_pairs_to_merge) {
+				if(is_fusion_size_limit_reached())
+					break;
+				aggregate_zone_pair(zone_pair_to_merge, zone_pair_updater);
+			}
+			batch |= zone_pairs_to_merge.size() > 1;
+		}
+		if(batch)
+			sort_zone_fusions_by_height();
+	}
+
+	// the remaining zone pairs are not merged, which skips the fusions of the largest zones
+	bool is_fusion_size_limit_reached() const {
+		return zone_fusions.size() >= fusion_size_limit;
+	}
+
+	void aggregate_zone_pair(zone_pair_iterator_type zone_pair_to_merge, const zone_pair_updater_type &zone_pair_updater) {
+		double height = get_fusion_height(*zone_pair_to_merge);
+		zone_fusions.push_back(zone_fusion_type(*zone_pair_to_merge, height));
+		zone_fusion_heights.push_back(zone_fusion_height_type(height, boost::prior(boost::end(zone_fusions))));
+		zone_heights[&zone_fusions.back().get_fusion()] = height;
+		zone_pair_queue.pop(zone_pair_to_merge);
+		zone_pair_adjacency.erase(zone_pair_to_merge);
+		zone_pairs.erase(zone_pair_to_merge);
+		zone_pair_updater.update_zone_pairs(zone_pairs, zone_fusions.back(), zone_pair_queue, zone_pair_adjacency);
+		// the fused zones are kept for the fusion maps but are no longer in any zone pair
+		zone_fusions.back().get_zone1().release_attribute_tree();
+		zone_fusions.back().get_zone2().release_attribute_tree();
+	}
+
+	double get_zone_height(const zone_type &zone) const {
+		typename zone_height_container_type::const_iterator zone_height = zone_heights.find(&zone);
+		return zone_height == zone_heights.end() ? -UTIL_DOUBLE_INFINITY : zone_height->second;
+	}
+
+	double get_fusion_height(const zone_pair_type &zone_pair) const {
+		return std::max(zone_pair.get_distance(), std::max(get_zone_height(zone_pair.get_zone1()), get_zone_height(zone_pair.get_zone2())));
+	}
+
+	struct zone_fusion_height_less {
+
+		bool operator()(const zone_fusion_height_type &lhs, const zone_fusion_height_type &rhs) const {
+			return lhs.first < rhs.first;
+		}
+	};
+
+	// the stable sort keeps a zone fusion after the fusions of its zones
+	void sort_zone_fusions_by_height() {
+		boost::stable_sort(zone_fusion_heights, zone_fusion_height_less());
+		for(const zone_fusion_height_type &zone_fusion_height : zone_fusion_heights)
+			zone_fusions.splice(boost::end(zone_fusions), zone_fusions, zone_fusion_height.second);
+	}
+};
+
+} // namespace geofis
+
+#endif // H84CDA6C0_2A85_4DE7_A5EC_153A877805C7 
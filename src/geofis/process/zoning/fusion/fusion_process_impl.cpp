@@ -37,28 +37,57 @@
  * knowledge of the CeCILL license and that you accept its terms.
  */
 #include <geofis/process/zoning/fusion/fusion_process_impl.hpp>
-#include <boost/assign/list_inserter.hpp>
+#include <geofis/process/zoning/fusion/fusion_process_engine.hpp>
+#include <geofis/algorithm/feature/feature_normalization.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/feature_distance.hpp>
+#include <boost/algorithm/cxx11/all_of.hpp>
 #include <util/range/ref_range.hpp>
 
 using namespace util;
 using namespace boost;
-using namespace boost::assign;
-using namespace boost::adaptors;
 
 namespace geofis {
 
+typedef fusion_process_traits::aggregation_type aggregation_type;
+typedef fusion_process_traits::zone_distance_type zone_distance_type;
+typedef fusion_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
+typedef fusion_process_traits::multidimensional_distance_type multidimensional_distance_type;
+typedef fusion_process_traits::attribute_distance_type attribute_distance_type;
+typedef fusion_process_traits::attribute_distance_range_type attribute_distance_range_type;
+typedef fusion_process_traits::feature_type feature_type;
+typedef fusion_process_traits::feature_range_type feature_range_type;
+typedef fusion_process_traits::zone_neighbor_range_type zone_neighbor_range_type;
+typedef feature_normalization<feature_type> feature_normalization_type;
+typedef euclidean_distance<double> euclidean_attribute_distance_type;
+
+// bounds the memory of the cached zone geometries, about a hundred bytes per vertex
+static const size_t zone_geometry_cache_vertex_limit = 1 << 20;
+
 fusion_process_impl::fusion_process_impl() {}
 
-fusion_process_impl::fusion_process_impl(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors) : aggregation(aggregation) {
-	normalize_attribute_distances(attribute_distances);
-	feature_distance = make_feature_distance<feature_distance_type>(multidimensional_distance, attribute_distances);
-	feature_normalization_type feature_normalization(feature_normalization_type::initialize(features));
-	feature_normalization.normalize(features);
-	initialize_zone_pairs_with_neighbors(zone_distance, zone_neighbors);
-	aggregate_zone_pairs(zone_pair_updater_type(feature_distance));
+fusion_process_impl::~fusion_process_impl() {}
+
+size_t fusion_process_impl::get_fusion_size() const {
+	return zone_fusions.size();
 }
 
-fusion_process_impl::~fusion_process_impl() {}
+fusion_process_impl::fusion_map_range_type fusion_process_impl::get_fusion_maps(zone_info_policy_type &zones, size_t begin, size_t end, bool compute_zones) {
+	return make_fusion_map_range(zone_fusions, begin, end, make_ref_range(zones), compute_zones);
+}
+
+fusion_process_impl::fusion_dendrogram_type fusion_process_impl::get_fusion_dendrogram(const zone_info_policy_type &zones) const {
+	return fusion_dendrogram_type(zones, zone_fusions);
+}
+
+void fusion_process_impl::compute_zone_geometries(const fusion_map_type &fusion_map, size_t thread_count) {
+	if(!zone_geometry_cache)
+		zone_geometry_cache.emplace(zone_fusions, zone_geometry_cache_vertex_limit);
+	zone_geometry_cache->compute_geometries(fusion_map.get_zones(), thread_count);
+}
+
+size_t fusion_process_impl::get_zone_geometry_vertex_size() const {
+	return zone_geometry_cache ? zone_geometry_cache->get_vertex_size() : 0;
+}
 
 struct normalize_attribute_distance {
 
@@ -69,6 +98,11 @@ struct normalize_attribute_distance {
 		void operator() (fispro::fuzzy_distance &fuzzy_distance) const {
 			fuzzy_distance.normalize();
 		}
+
+		void operator() (tabulated_fuzzy_distance &tabulated_fuzzy_distance) const {
+			tabulated_fuzzy_distance.get_distance().normalize();
+			tabulated_fuzzy_distance.tabulate();
+		}
 	};
 
 	template <BOOST_VARIANT_ENUM_PARAMS(class T)> void operator() (boost::variant<BOOST_VARIANT_ENUM_PARAMS(T)> &attribute_distance) {
@@ -76,121 +110,165 @@ struct normalize_attribute_distance {
 	}
 };
 
-void fusion_process_impl::normalize_attribute_distances(attribute_distance_range_type &attribute_distances) {
+static void normalize_attribute_distances(attribute_distance_range_type &attribute_distances) {
 	for_each(attribute_distances, normalize_attribute_distance());
 }
 
-void fusion_process_impl::initialize_zone_pairs_with_neighbors(const zone_distance_type &zone_distance, zone_neighbor_range_type &zone_neighbors) {
-	push_back(zone_pairs).range(transform(zone_neighbors, neighbor_to_zone_pair_type(zone_distance, feature_distance)));
+static void normalize_features(feature_range_type &features) {
+	feature_normalization_type feature_normalization(feature_normalization_type::initialize(features));
+	feature_normalization.normalize(features);
 }
 
-/**
-@startuml
+struct is_euclidean_attribute_distance {
 
-title aggregate_zone_pairs activity diagram\n
+	bool operator()(const attribute_distance_type &attribute_distance) const {
+		return boost::get<euclidean_attribute_distance_type>(&attribute_distance) != nullptr;
+	}
+};
 
-start
+static bool are_euclidean_attribute_distances(const attribute_distance_range_type &attribute_distances) {
+	return boost::algorithm::all_of(attribute_distances, is_euclidean_attribute_distance());
+}
 
-floating note left: In this diagram **zone_pair** and **zone_pair_to_merge** are an iterator type.
+// fispro::fuzzy_distance evaluates the membership degrees in the fuzzy partition, which is not thread safe
+struct is_thread_safe_attribute_distance {
 
-:transform **zone_neighbors** to **zone_pairs**;
-:sort **zone_pairs** by id comparator;
-note right
-	this guarantees algorithm reproducibility
-	CGAL delaunay triangulation is not reproducible
-	so **zone_neighbors** are not ordered
+	bool operator()(const attribute_distance_type &attribute_distance) const {
+		return boost::get<fispro::fuzzy_distance>(&attribute_distance) == nullptr;
+	}
+};
 
-	**zone_pairs** is std::list<zone_pair>
-	this guarantees iterator validity on remove operation
-end note
+static bool are_thread_safe_attribute_distances(const attribute_distance_range_type &attribute_distances) {
+	return boost::algorithm::all_of(attribute_distances, is_thread_safe_attribute_distance());
+}
+
+// with the zone neighborhood constraint, reciprocal_nearest_aggregation gives the minimum_aggregation fusions only for the maximum zone distance
+template <class ZoneDistance> aggregation_type get_zone_distance_aggregation(const aggregation_type &aggregation, const ZoneDistance &) {
+	if(boost::get<reciprocal_nearest_aggregation>(&aggregation))
+		return minimum_aggregation();
+	return aggregation;
+}
 
-while(**zone_pairs** empty ?) is (false)
-	:copy all **zone_pair** to merge in **zone_pairs_to_merge**
-	according the **aggregation** function;
-	note right
-		the **aggregation** function must guarantees that
-		**zone_pairs** are ordered by merging order and
-		**zone_pairs_to_merge** have same merging order
+static aggregation_type get_zone_distance_aggregation(const aggregation_type &aggregation, const util::maximum<double> &) {
+	return aggregation;
+}
 
-		**zone_pairs_to_merge** is std::list<**zone_pair**>
-		this guarantees iterator validity on remove operation
-	end note
+template <class ZoneDistance> size_t get_zone_distance_thread_count(size_t thread_count, const ZoneDistance &) {
+	return thread_count;
+}
 
-	:**zone_pair_to_merge** first element of **zone_pairs_to_merge**
-	build **zone_fusion** with **zone_pair_to_merge**
-	copy **zone_fusion** in **zone_fusions**;
+// the ward zone distance computes the normalized means of the zones on first use, which is not thread safe
+static size_t get_zone_distance_thread_count(size_t, const ward_zone_distance &) {
+	return 1;
+}
 
-	:remove **zone_pair_to_merge** in **zone_pairs_to_merge**
-	remove **zone_pair_to_merge** in **zone_pairs**;
+/**
+@startuml
 
-	:update all **zone_pairs** according **zone_pair_updater** and **zone_fusion**;
-end while (true)
+title make_fusion_process_impl activity diagram\n
+
+start
+
+:normalize **attribute_distances** and **features**;
+:**fusion_size_limit** is the number of **features**
+minus **minimum_zone_count**, or 0;
+if(fuzzy attribute distance ?) then (true)
+	:**thread_count** is 1;
+endif
+
+if(one attribute ?) then (true)
+	if(euclidean attribute distance ?) then (true)
+		:**feature_distance** is feature_distance<void, euclidean_distance>;
+	else (false)
+		:**feature_distance** is feature_distance<void, variant_attribute_distance>;
+	endif
+else (false)
+	:visit **multidimensional_distance**;
+	if(all euclidean attribute distances ?) then (true)
+		:**feature_distance** is feature_distance<MultidimensionalDistance, void>;
+		note right
+			the multidimensional distance is computed
+			directly on the normalized attribute rows
+		end note
+	else (false)
+		:**feature_distance** is feature_distance<MultidimensionalDistance, variant_attribute_distance>;
+	endif
+endif
+
+:visit **zone_distance**;
+if(reciprocal nearest aggregation and not maximum zone distance ?) then (true)
+	:**aggregation** is minimum aggregation;
+endif
+if(ward zone distance ?) then (true)
+	:**thread_count** is 1;
+endif
+:build fusion_process_engine<ZoneDistance, FeatureDistance>;
 
 end
 
 @enduml
 */
 
-struct print_zone_pair_size {
+template <class FeatureDistance> struct fusion_process_engine_maker : boost::static_visitor<fusion_process_impl *> {
+
+	fusion_process_engine_maker(const aggregation_type &aggregation, const FeatureDistance &feature_distance, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t fusion_size_limit) : aggregation(aggregation), feature_distance(feature_distance), zone_neighbors(zone_neighbors), thread_count(thread_count), sampling(sampling), fusion_size_limit(fusion_size_limit) {}
 
-	template <class ZonePairIterator> void operator()(ZonePairIterator zone_pair_iterator) const {
-		std::cout << "zone pair - " << zone_pair_iterator->get_zone1().size() << " - " << zone_pair_iterator->get_zone2().size() << std::endl;
+	template <class ZoneDistance> fusion_process_impl *operator()(const ZoneDistance &zone_distance) const {
+		return new fusion_process_engine<ZoneDistance, FeatureDistance>(get_zone_distance_aggregation(aggregation, zone_distance), zone_distance, feature_distance, zone_neighbors, get_zone_distance_thread_count(thread_count, zone_distance), sampling, fusion_size_limit);
 	}
+
+	const aggregation_type &aggregation;
+	const FeatureDistance &feature_distance;
+	zone_neighbor_range_type zone_neighbors;
+	size_t thread_count;
+	const feature_distance_sampling_type &sampling;
+	size_t fusion_size_limit;
 };
 
-/**
- * Compare 2 zone_pairs according to their maximum size
- */
-struct zone_pair_max_size_comparator {
+template <class FeatureDistance> fusion_process_impl *make_fusion_process_engine(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const FeatureDistance &feature_distance, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t fusion_size_limit) {
+	return boost::apply_visitor(fusion_process_engine_maker<FeatureDistance>(aggregation, feature_distance, zone_neighbors, thread_count, sampling, fusion_size_limit), zone_distance);
+}
 
-	template <class ZonePairIterator> bool operator()(ZonePairIterator lhs, ZonePairIterator rhs) const {
-		size_t max_size_lhs = std::max(lhs->get_zone1().size(), lhs->get_zone2().size());
-		size_t max_size_rhs = std::max(rhs->get_zone1().size(), rhs->get_zone2().size());
-		return max_size_lhs > max_size_rhs;
-	}
-};
+struct multidimensional_fusion_process_engine_maker : boost::static_visitor<fusion_process_impl *> {
 
-/**
- * Compare 2 zone_pairs according to their resulting size after fusion
- */
-struct zone_pair_size_comparator {
+	multidimensional_fusion_process_engine_maker(const aggregation_type &aggregation, const zone_distance_type &zone_distance, attribute_distance_range_type attribute_distances, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t fusion_size_limit) : aggregation(aggregation), zone_distance(zone_distance), attribute_distances(attribute_distances), zone_neighbors(zone_neighbors), thread_count(thread_count), sampling(sampling), fusion_size_limit(fusion_size_limit) {}
 
-	template <class ZonePairIterator> bool operator()(ZonePairIterator lhs, ZonePairIterator rhs) const {
-		size_t size_lhs = lhs->get_zone1().size() + lhs->get_zone2().size();
-		size_t size_rhs = rhs->get_zone1().size() + rhs->get_zone2().size();
-		return size_lhs > size_rhs;
+	template <class MultidimensionalDistance> fusion_process_impl *operator()(const MultidimensionalDistance &multidimensional_distance) const {
+		if(are_euclidean_attribute_distances(attribute_distances))
+			// the euclidean attribute distance is |lhs - rhs|, so the multidimensional distance gives the same result on the attribute rows
+			return make_fusion_process_engine(aggregation, zone_distance, make_multidimensional_feature_distance(multidimensional_distance), zone_neighbors, thread_count, sampling, fusion_size_limit);
+		return make_fusion_process_engine(aggregation, zone_distance, make_multidimensional_feature_distance<attribute_distance_type>(multidimensional_distance, attribute_distances), zone_neighbors, thread_count, sampling, fusion_size_limit);
 	}
-};
 
-void fusion_process_impl::aggregate_zone_pairs(const zone_pair_updater_type &zone_pair_updater) {
-    zone_pairs.sort(zone_pair_id_comparator());
-	while(!zone_pairs.empty()) {
-		zone_pair_iterator_container_type zone_pairs_to_merge;
-		aggregation(zone_pairs, std::back_inserter(zone_pairs_to_merge));
-		// try to sorting zone_pairs_to_merge according a comparison function.
-		// not retained: difficult to compare resulting maps.
-		//if(zone_pairs_to_merge.size() > 1) {
-			//std::cout << zone_pairs_to_merge.size() << " zone_pairs_to_merge" << std::endl;
-			//zone_pairs_to_merge.sort(zone_pair_size_comparator());
-			//for_each(zone_pairs_to_merge, print_zone_pair_size());
-		//}
-		aggregate_zone_pair(zone_pairs_to_merge.front(), zone_pair_updater, zone_pairs_to_merge);
-	}
-}
+	const aggregation_type &aggregation;
+	const zone_distance_type &zone_distance;
+	attribute_distance_range_type attribute_distances;
+	zone_neighbor_range_type zone_neighbors;
+	size_t thread_count;
+	const feature_distance_sampling_type &sampling;
+	size_t fusion_size_limit;
+};
 
-void fusion_process_impl::aggregate_zone_pair(zone_pair_iterator_type zone_pair_to_merge, const zone_pair_updater_type &zone_pair_updater, zone_pair_iterator_container_type &zone_pairs_to_merge) {
-	zone_fusions.push_back(zone_fusion_type(*zone_pair_to_merge));
-	zone_pairs_to_merge.remove(zone_pair_to_merge);
-	zone_pairs.erase(zone_pair_to_merge);
-	zone_pair_updater.update_zone_pairs(zone_pairs, zone_fusions.back(), zone_pairs_to_merge);
+static fusion_process_impl *make_monodimensional_fusion_process_engine(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const attribute_distance_type &attribute_distance, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t fusion_size_limit) {
+	if(is_euclidean_attribute_distance()(attribute_distance))
+		return make_fusion_process_engine(aggregation, zone_distance, make_monodimensional_feature_distance<euclidean_attribute_distance_type>(attribute_distance), zone_neighbors, thread_count, sampling, fusion_size_limit);
+	return make_fusion_process_engine(aggregation, zone_distance, make_monodimensional_feature_distance<attribute_distance_type>(attribute_distance), zone_neighbors, thread_count, sampling, fusion_size_limit);
 }
 
-size_t fusion_process_impl::get_fusion_size() const {
-	return zone_fusions.size();
+// the fusion process stops when **minimum_zone_count** zones remain, each fusion merges 2 zones in 1
+static size_t get_fusion_size_limit(size_t zone_count, size_t minimum_zone_count) {
+	return zone_count > minimum_zone_count ? zone_count - minimum_zone_count : 0;
 }
 
-fusion_process_impl::fusion_map_range_type fusion_process_impl::get_fusion_maps(zone_info_policy_type &zones, size_t begin, size_t end, bool compute_zones) {
-	return make_fusion_map_range(zone_fusions, begin, end, make_ref_range(zones), compute_zones);
+fusion_process_impl *fusion_process_impl::make_fusion_process_impl(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t minimum_zone_count) {
+	size_t fusion_size_limit = get_fusion_size_limit(boost::size(features), minimum_zone_count);
+	normalize_attribute_distances(attribute_distances);
+	normalize_features(features);
+	if(!are_thread_safe_attribute_distances(attribute_distances))
+		thread_count = 1;
+	if(boost::size(attribute_distances) == 1)
+		return make_monodimensional_fusion_process_engine(aggregation, zone_distance, attribute_distances.front(), zone_neighbors, thread_count, sampling, fusion_size_limit);
+	return boost::apply_visitor(multidimensional_fusion_process_engine_maker(aggregation, zone_distance, attribute_distances, zone_neighbors, thread_count, sampling, fusion_size_limit), multidimensional_distance);
 }
 
 } // namespace geofis
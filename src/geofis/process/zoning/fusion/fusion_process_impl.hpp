@@ -39,15 +39,8 @@
 #ifndef H941EF80A_E62F_4855_B5E5_651F5F416D3A
 #define H941EF80A_E62F_4855_B5E5_651F5F416D3A
 
-#include <list>
+#include <boost/optional.hpp>
 #include <geofis/process/zoning/fusion/fusion_process_traits.hpp>
-#include <geofis/algorithm/feature/feature_normalization.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair_distance.hpp>
-#include <geofis/algorithm/zoning/fusion/aggregation/aggregation_adaptor.hpp>
-#include <geofis/algorithm/zoning/fusion/neighbor_to_zone_pair.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair_distance_updater.hpp>
-#include <geofis/algorithm/zoning/pair/zone_pair_updater.hpp>
 
 namespace geofis {
 
@@ -55,53 +48,41 @@ class fusion_process_impl {
 
 	typedef fusion_process_traits::aggregation_type aggregation_type;
 	typedef fusion_process_traits::zone_distance_type zone_distance_type;
+	typedef fusion_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
 	typedef fusion_process_traits::multidimensional_distance_type multidimensional_distance_type;
 	typedef fusion_process_traits::attribute_distance_range_type attribute_distance_range_type;
 	typedef fusion_process_traits::feature_range_type feature_range_type;
 	typedef fusion_process_traits::zone_neighbor_range_type zone_neighbor_range_type;
 
-	typedef aggregation_adaptor<aggregation_type> aggregation_adaptor_type;
-
-	typedef fusion_process_traits::feature_distance_type feature_distance_type;
-
-	typedef fusion_process_traits::feature_type feature_type;
-	typedef feature_normalization<feature_type> feature_normalization_type;
+	typedef fusion_process_traits::zone_info_policy_type zone_info_policy_type;
+	typedef fusion_process_traits::fusion_map_type fusion_map_type;
+	typedef fusion_process_traits::fusion_map_range_type fusion_map_range_type;
+	typedef fusion_process_traits::fusion_dendrogram_type fusion_dendrogram_type;
+	typedef fusion_process_traits::zone_geometry_cache_type zone_geometry_cache_type;
 
-	typedef zone_pair_distance<zone_distance_type> zone_pair_distance_type;
-	typedef fusion_process_traits::zone_type zone_type;
-	typedef zone_pair<zone_type, zone_pair_distance_type> zone_pair_type;
-	typedef std::list<zone_pair_type> zone_pair_container_type;
-	typedef typename boost::range_iterator<zone_pair_container_type>::type zone_pair_iterator_type;
-	typedef std::list<zone_pair_iterator_type> zone_pair_iterator_container_type;
-	typedef neighbor_to_zone_pair<zone_type, zone_distance_type, feature_distance_type> neighbor_to_zone_pair_type;
+	boost::optional<zone_geometry_cache_type> zone_geometry_cache;
 
+protected:
 	typedef fusion_process_traits::zone_fusion_type zone_fusion_type;
 	typedef fusion_process_traits::zone_fusion_container_type zone_fusion_container_type;
 
-	typedef zone_pair_distance_updater<feature_distance_type> zone_pair_distance_updater_type;
-	typedef zone_pair_updater<zone_pair_distance_updater_type> zone_pair_updater_type;
-
-	typedef fusion_process_traits::zone_info_policy_type zone_info_policy_type;
-	typedef fusion_process_traits::fusion_map_range_type fusion_map_range_type;
-
-	aggregation_adaptor_type aggregation;
-	feature_distance_type feature_distance;
-	zone_pair_container_type zone_pairs;
 	zone_fusion_container_type zone_fusions;
 
-public:
 	fusion_process_impl();
-	fusion_process_impl(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors);
-	~fusion_process_impl();
+
+public:
+	virtual ~fusion_process_impl();
 
 	size_t get_fusion_size() const;
 	fusion_map_range_type get_fusion_maps(zone_info_policy_type &zones, size_t begin, size_t end, bool compute_zones = false);
-
-private:
-	void initialize_zone_pairs_with_neighbors(const zone_distance_type &zone_distance, zone_neighbor_range_type &zone_neighbors);
-	void aggregate_zone_pairs(const zone_pair_updater_type &zone_pair_updater);
-	void aggregate_zone_pair(zone_pair_iterator_type zone_pair_to_merge, const zone_pair_updater_type &zone_pair_updater, zone_pair_iterator_container_type &zone_pairs_to_merge);
-	void normalize_attribute_distances(attribute_distance_range_type &attribute_distances);
+	fusion_dendrogram_type get_fusion_dendrogram(const zone_info_policy_type &zones) const;
+	//! computes the geometries of the zones of **fusion_map** with **thread_count** threads, joined from the geometries of the zones of their fusions
+	void compute_zone_geometries(const fusion_map_type &fusion_map, size_t thread_count = 1);
+	//! number of vertices of the cached zone geometries, 0 before the first compute_zone_geometries
+	size_t get_zone_geometry_vertex_size() const;
+
+	//! normalizes **attribute_distances** and **features**, then builds the fusion_process_engine specialized for the distances held by the variants
+	static fusion_process_impl *make_fusion_process_impl(const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, attribute_distance_range_type attribute_distances, feature_range_type &features, zone_neighbor_range_type zone_neighbors, size_t thread_count, const feature_distance_sampling_type &sampling, size_t minimum_zone_count);
 };
 
 } // namespace geofis
@@ -50,6 +50,7 @@ struct fusion_process_traits {
 	typedef zoning_process_traits::multidimensional_distance_type multidimensional_distance_type;
 	typedef zoning_process_traits::feature_distance_type feature_distance_type;
 	typedef zoning_process_traits::attribute_distance_range_type attribute_distance_range_type;
+	typedef zoning_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
 
 	typedef zoning_process_traits::feature_range_type feature_range_type;
 	typedef zoning_process_traits::zone_neighbor_range_type zone_neighbor_range_type;
@@ -64,7 +65,10 @@ struct fusion_process_traits {
 	typedef zoning_process_traits::zone_fusion_container_type zone_fusion_container_type;
 
 	typedef zoning_process_traits::zone_info_policy_type zone_info_policy_type;
+	typedef zoning_process_traits::fusion_map_type fusion_map_type;
 	typedef zoning_process_traits::fusion_map_range_type fusion_map_range_type;
+	typedef zoning_process_traits::fusion_dendrogram_type fusion_dendrogram_type;
+	typedef zoning_process_traits::zone_geometry_cache_type zone_geometry_cache_type;
 };
 
 } // namespace geofis
@@ -58,6 +58,14 @@ size_t merge_process::get_merge_size() const {
 	return impl->get_merge_size();
 }
 
+size_t merge_process::get_minimum_merge_zone_count() const {
+	return impl->get_minimum_merge_zone_count();
+}
+
+const merge_process::fusion_map_type &merge_process::get_fusion_map(size_t map_index) const {
+	return impl->get_fusion_map(map_index);
+}
+
 merge_process::merge_map_type merge_process::get_merge_map(size_t map_index, const neighborhood_type &neighborhood, const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, const const_attribute_distance_range_type &attribute_distances) const {
 	return impl->get_merge_map(map_index, neighborhood, aggregation, zone_distance, multidimensional_distance, attribute_distances);
 }
@@ -48,6 +48,7 @@ class merge_process_impl;
 
 class merge_process {
 
+	typedef merge_process_traits::fusion_map_type fusion_map_type;
 	typedef merge_process_traits::fusion_map_range_type fusion_map_range_type;
 	typedef merge_process_traits::merge_type merge_type;
 	typedef merge_process_traits::merge_map_type merge_map_type;
@@ -76,6 +77,8 @@ public:
 	}
 
 	size_t get_merge_size() const;
+	size_t get_minimum_merge_zone_count() const;
+	const fusion_map_type &get_fusion_map(size_t map_index) const;
 
 	merge_map_type get_merge_map(size_t map_index, const neighborhood_type &neighborhood, const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, const const_attribute_distance_range_type &attribute_distances) const;
 
@@ -44,6 +44,7 @@
 #include <geofis/algorithm/zoning/fusion/distance/zone_distance_adapter.hpp>
 #include <util/functional/unary_adaptor.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/algorithm/count_if.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 
 using namespace util;
@@ -59,6 +60,8 @@ merge_process_impl::merge_process_impl(const fusion_map_range_type &fusion_map_r
 	auto end_filter_iterator = make_filter_iterator(merge_map_predicate, boost::end(reversed_fusion_map_range), boost::end(reversed_fusion_map_range));
 	fusion_maps.assign(begin_filter_iterator, end_filter_iterator);
 	UTIL_ENSURE(fusion_maps.size() >= 1);
+	// the fusion maps can stop before a single zone remains, the next merge maps have one more zone each
+	minimum_merge_zone_count = boost::count_if(fusion_maps.front().get_zones(), [this](auto &zone) { return merge_predicate(zone); });
 }
 
 merge_process_impl::~merge_process_impl() {}
@@ -67,6 +70,15 @@ size_t merge_process_impl::get_merge_size() const {
 	return fusion_maps.size();
 }
 
+size_t merge_process_impl::get_minimum_merge_zone_count() const {
+	return minimum_merge_zone_count;
+}
+
+const merge_process_impl::fusion_map_type &merge_process_impl::get_fusion_map(size_t map_index) const {
+	UTIL_REQUIRE(map_index < fusion_maps.size());
+	return fusion_maps[map_index];
+}
+
 merge_process_impl::merge_map_type merge_process_impl::get_merge_map(size_t map_index, const neighborhood_type &neighborhood, const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, const const_attribute_distance_range_type &attribute_distances) const {
 
 	typedef merge_process_traits::zone_type zone_type;
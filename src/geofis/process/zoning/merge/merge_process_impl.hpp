@@ -60,12 +60,16 @@ class merge_process_impl {
 
 	merge_predicate_type merge_predicate;
 	fusion_map_container_type fusion_maps;
+	size_t minimum_merge_zone_count;
 
 public:
 	merge_process_impl(const fusion_map_range_type &fusion_map_range, const merge_type &merge);
 	~merge_process_impl();
 
 	size_t get_merge_size() const;
+	size_t get_minimum_merge_zone_count() const;
+	//! fusion map merged by the merge map **map_index**
+	const fusion_map_type &get_fusion_map(size_t map_index) const;
 
 	merge_map_type get_merge_map(size_t map_index, const neighborhood_type &neighborhood, const aggregation_type &aggregation, const zone_distance_type &zone_distance, const multidimensional_distance_type &multidimensional_distance, const const_attribute_distance_range_type &attribute_distances) const;
 };
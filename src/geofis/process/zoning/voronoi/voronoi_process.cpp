@@ -45,7 +45,7 @@ namespace geofis {
 
 voronoi_process::voronoi_process() : impl(nullptr) {}
 
-voronoi_process::voronoi_process(const feature_range_type &features, const polygon_type &border) : impl(new voronoi_process_impl(features, border)) {}
+voronoi_process::voronoi_process(const feature_range_type &features, const polygon_type &border, bool inexact, size_t thread_count) : impl(new voronoi_process_impl(features, border, inexact, thread_count)) {}
 
 voronoi_process::~voronoi_process() {}
 
@@ -60,7 +60,7 @@ class voronoi_process {
 
 public:
 	voronoi_process();
-	voronoi_process(const feature_range_type &features, const polygon_type &border);
+	voronoi_process(const feature_range_type &features, const polygon_type &border, bool inexact, size_t thread_count);
 	~voronoi_process();
 
 	voronoi_process & operator= (BOOST_RV_REF(voronoi_process) other) {
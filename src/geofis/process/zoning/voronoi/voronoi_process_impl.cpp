@@ -40,8 +40,8 @@
 
 namespace geofis {
 
-voronoi_process_impl::voronoi_process_impl(const feature_range_type &features, const polygon_type &border) {
-	voronoi_map.initialize(features, border, zones);
+voronoi_process_impl::voronoi_process_impl(const feature_range_type &features, const polygon_type &border, bool inexact, size_t thread_count) {
+	voronoi_map.initialize(features, border, zones, inexact, thread_count);
 }
 
 voronoi_process_impl::~voronoi_process_impl() {}
@@ -55,7 +55,7 @@ class voronoi_process_impl {
 	voronoi_map_type voronoi_map;
 
 public:
-	voronoi_process_impl(const feature_range_type &features, const polygon_type &border);
+	voronoi_process_impl(const feature_range_type &features, const polygon_type &border, bool inexact, size_t thread_count);
 	~voronoi_process_impl();
 
 	zone_info_policy_type &get_zones();
@@ -55,6 +55,10 @@ zoning_process::polygon_type zoning_process::get_border() const {
 	return impl->get_border();
 }
 
+void zoning_process::set_inexact_voronoi(bool inexact_voronoi) {
+	impl->set_inexact_voronoi(inexact_voronoi);
+}
+
 void zoning_process::compute_voronoi_process() {
 	impl->compute_voronoi_process();
 }
@@ -111,6 +115,30 @@ void zoning_process::set_attribute_distances(const attribute_distance_container_
 	impl->set_attribute_distances(attribute_distances);
 }
 
+void zoning_process::set_thread_count(size_t thread_count) {
+	impl->set_thread_count(thread_count);
+}
+
+size_t zoning_process::get_thread_count() const {
+	return impl->get_thread_count();
+}
+
+void zoning_process::set_feature_distance_sampling(const feature_distance_sampling_type &feature_distance_sampling) {
+	impl->set_feature_distance_sampling(feature_distance_sampling);
+}
+
+const zoning_process::feature_distance_sampling_type &zoning_process::get_feature_distance_sampling() const {
+	return impl->get_feature_distance_sampling();
+}
+
+void zoning_process::set_minimum_zone_count(size_t minimum_zone_count) {
+	impl->set_minimum_zone_count(minimum_zone_count);
+}
+
+size_t zoning_process::get_minimum_zone_count() const {
+	return impl->get_minimum_zone_count();
+}
+
 void zoning_process::compute_fusion_process() {
 	impl->compute_fusion_process();
 }
@@ -135,6 +163,10 @@ zoning_process::reverse_fusion_map_range_type zoning_process::get_reverse_fusion
 	return reverse(impl->get_fusion_maps(begin, end, compute_zones));
 }
 
+zoning_process::fusion_dendrogram_type zoning_process::get_fusion_dendrogram() {
+	return impl->get_fusion_dendrogram();
+}
+
 size_t zoning_process::get_unique_feature_size() const {
 	return impl->get_unique_feature_size();
 }
@@ -167,6 +199,18 @@ size_t zoning_process::get_merge_size() const {
 	return impl->get_merge_size();
 }
 
+size_t zoning_process::get_minimum_merge_zone_count() const {
+	return impl->get_minimum_merge_zone_count();
+}
+
+void zoning_process::compute_merge_map_geometries(size_t map_index) {
+	impl->compute_merge_map_geometries(map_index);
+}
+
+size_t zoning_process::get_zone_geometry_vertex_size() const {
+	return impl->get_zone_geometry_vertex_size();
+}
+
 zoning_process::merge_map_type zoning_process::get_merge_map(size_t map_index) const {
 	return impl->get_merge_map(map_index);
 }
@@ -56,9 +56,11 @@ class zoning_process {
 	typedef zoning_process_traits::aggregation_type aggregation_type;
 	typedef zoning_process_traits::attribute_distance_container_type attribute_distance_container_type;
 	typedef zoning_process_traits::zone_distance_type zone_distance_type;
+	typedef zoning_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
 	typedef zoning_process_traits::multidimensional_distance_type multidimensional_distance_type;
 	typedef zoning_process_traits::fusion_map_type fusion_map_type;
 	typedef zoning_process_traits::fusion_map_range_type fusion_map_range_type;
+	typedef zoning_process_traits::fusion_dendrogram_type fusion_dendrogram_type;
 	typedef zoning_process_traits::reverse_fusion_map_range_type reverse_fusion_map_range_type;
 	typedef zoning_process_traits::merge_type merge_type;
 	typedef zoning_process_traits::merge_map_type merge_map_type;
@@ -71,6 +73,8 @@ public:
 
 	void set_border(const polygon_type &border);
 	polygon_type get_border() const;
+	//! with **inexact_voronoi**, the voronoi vertices are constructed with the inexact kernel, see voronoi_map::initialize
+	void set_inexact_voronoi(bool inexact_voronoi);
 	void compute_voronoi_process();
 	void release_voronoi_process();
 	bool is_voronoi_implemented() const;
@@ -90,11 +94,18 @@ public:
 	void set_zone_distance(const zone_distance_type &zone_distance);
 	void set_multidimensional_distance(const multidimensional_distance_type &multidimensional_distance);
 	void set_attribute_distances(const attribute_distance_container_type &attribute_distances);
+	void set_thread_count(size_t thread_count);
+	size_t get_thread_count() const;
+	void set_feature_distance_sampling(const feature_distance_sampling_type &feature_distance_sampling);
+	const feature_distance_sampling_type &get_feature_distance_sampling() const;
+	void set_minimum_zone_count(size_t minimum_zone_count);
+	size_t get_minimum_zone_count() const;
 	void compute_fusion_process();
 	void release_fusion_process();
 	bool is_fusion_implemented() const;
 	size_t get_fusion_size() const;
 	fusion_map_range_type get_fusion_maps(size_t begin, size_t end, bool compute_zones);
+	fusion_dendrogram_type get_fusion_dendrogram();
 	reverse_fusion_map_range_type get_reverse_fusion_maps(size_t begin, size_t end, bool compute_zones);
 
 	void set_merge(const merge_type &merge);
@@ -103,6 +114,12 @@ public:
 	void release_merge_process();
 	bool is_merge_implemented() const;
 	size_t get_merge_size() const;
+	size_t get_minimum_merge_zone_count() const;
+	//! computes the zone geometries of the merge map **map_index** with the thread count, the next get_merge_map only copies them
+	void compute_merge_map_geometries(size_t map_index);
+	//! number of vertices of the zone geometries cached by compute_merge_map_geometries
+	size_t get_zone_geometry_vertex_size() const;
+	//! the zones of the merge map have no geometry until compute_merge_map_geometries **map_index**
 	merge_map_type get_merge_map(size_t map_index) const;
 };
 
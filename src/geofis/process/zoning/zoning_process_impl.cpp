@@ -54,7 +54,7 @@ using namespace boost;
 
 namespace geofis {
 
-zoning_process_impl::zoning_process_impl(const feature_container_type &features) : features(features) {
+zoning_process_impl::zoning_process_impl(const feature_container_type &features) : features(features), inexact_voronoi(false), thread_count(1), minimum_zone_count(1) {
 	initialize_features();
 }
 
@@ -79,8 +79,12 @@ zoning_process_impl::polygon_type zoning_process_impl::get_border() const {
 	return border;
 }
 
+void zoning_process_impl::set_inexact_voronoi(bool inexact_voronoi) {
+	this->inexact_voronoi = inexact_voronoi;
+}
+
 void zoning_process_impl::compute_voronoi_process() {
-	voronoi_process_type _voronoi_process(bounded_features, border);
+	voronoi_process_type _voronoi_process(bounded_features, border, inexact_voronoi, thread_count);
 	this->_voronoi_process = boost::move(_voronoi_process);
 }
 
@@ -139,8 +143,34 @@ void zoning_process_impl::set_attribute_distances(const attribute_distance_conta
 	this->attribute_distances = attribute_distances;
 }
 
+void zoning_process_impl::set_thread_count(size_t thread_count) {
+	UTIL_REQUIRE(thread_count > 0);
+	this->thread_count = thread_count;
+}
+
+size_t zoning_process_impl::get_thread_count() const {
+	return thread_count;
+}
+
+void zoning_process_impl::set_feature_distance_sampling(const feature_distance_sampling_type &feature_distance_sampling) {
+	this->feature_distance_sampling = feature_distance_sampling;
+}
+
+const zoning_process_impl::feature_distance_sampling_type &zoning_process_impl::get_feature_distance_sampling() const {
+	return feature_distance_sampling;
+}
+
+void zoning_process_impl::set_minimum_zone_count(size_t minimum_zone_count) {
+	UTIL_REQUIRE(minimum_zone_count > 0);
+	this->minimum_zone_count = minimum_zone_count;
+}
+
+size_t zoning_process_impl::get_minimum_zone_count() const {
+	return minimum_zone_count;
+}
+
 void zoning_process_impl::compute_fusion_process() {
-	fusion_process_type _fusion_process(aggregation, zone_distance, multidimensional_distance, attribute_distances, bounded_features, _neighborhood_process.get_zone_neighbors());
+	fusion_process_type _fusion_process(aggregation, zone_distance, multidimensional_distance, attribute_distances, bounded_features, _neighborhood_process.get_zone_neighbors(), thread_count, feature_distance_sampling, minimum_zone_count);
 	this->_fusion_process = boost::move(_fusion_process);
 }
 
@@ -161,6 +191,10 @@ zoning_process_impl::fusion_map_range_type zoning_process_impl::get_fusion_maps(
 	return _fusion_process.get_fusion_maps(_voronoi_process.get_zones(), begin, end, compute_zones);
 }
 
+zoning_process_impl::fusion_dendrogram_type zoning_process_impl::get_fusion_dendrogram() {
+	return _fusion_process.get_fusion_dendrogram(_voronoi_process.get_zones());
+}
+
 size_t zoning_process_impl::get_unique_feature_size() const {
 	return distance(unique_features);
 }
@@ -197,6 +231,18 @@ size_t zoning_process_impl::get_merge_size() const {
 	return _merge_process.get_merge_size();
 }
 
+size_t zoning_process_impl::get_minimum_merge_zone_count() const {
+	return _merge_process.get_minimum_merge_zone_count();
+}
+
+void zoning_process_impl::compute_merge_map_geometries(size_t map_index) {
+	_fusion_process.compute_zone_geometries(_merge_process.get_fusion_map(map_index), thread_count);
+}
+
+size_t zoning_process_impl::get_zone_geometry_vertex_size() const {
+	return _fusion_process.is_implemented() ? _fusion_process.get_zone_geometry_vertex_size() : 0;
+}
+
 zoning_process_impl::merge_map_type zoning_process_impl::get_merge_map(size_t map_index) const {
 	return _merge_process.get_merge_map(map_index, neighborhood, aggregation, zone_distance, multidimensional_distance, attribute_distances);
 }
@@ -59,12 +59,14 @@ class zoning_process_impl {
 	typedef neighborhood_process neighborhood_process_type;
 	typedef zoning_process_traits::aggregation_type aggregation_type;
 	typedef zoning_process_traits::zone_distance_type zone_distance_type;
+	typedef zoning_process_traits::feature_distance_sampling_type feature_distance_sampling_type;
 	typedef zoning_process_traits::multidimensional_distance_type multidimensional_distance_type;
 	typedef zoning_process_traits::attribute_distance_type attribute_distance_type;
 	typedef zoning_process_traits::attribute_distance_container_type attribute_distance_container_type;
 	typedef fusion_process fusion_process_type;
 	typedef zoning_process_traits::fusion_map_type fusion_map_type;
 	typedef zoning_process_traits::fusion_map_range_type fusion_map_range_type;
+	typedef zoning_process_traits::fusion_dendrogram_type fusion_dendrogram_type;
 	typedef zoning_process_traits::merge_type merge_type;
 	typedef zoning_process_traits::merge_map_type merge_map_type;
 	typedef merge_process merge_process_type;
@@ -73,6 +75,7 @@ class zoning_process_impl {
 	feature_container_type features;
 	feature_range_type unique_features;
 	feature_range_type bounded_features;
+	bool inexact_voronoi;
 	voronoi_process_type _voronoi_process;
 	neighborhood_type neighborhood;
 	neighborhood_process_type _neighborhood_process;
@@ -80,13 +83,16 @@ class zoning_process_impl {
 	zone_distance_type zone_distance;
 	multidimensional_distance_type multidimensional_distance;
 	attribute_distance_container_type attribute_distances;
+	size_t thread_count;
+	feature_distance_sampling_type feature_distance_sampling;
+	size_t minimum_zone_count;
 	fusion_process_type _fusion_process;
 	merge_type merge;
 	merge_process_type _merge_process;
 
 public:
 	zoning_process_impl(const feature_container_type &features);
-	template <class FeatureRange> zoning_process_impl(const FeatureRange &features) : features(boost::begin(features), boost::end(features)) {
+	template <class FeatureRange> zoning_process_impl(const FeatureRange &features) : features(boost::begin(features), boost::end(features)), inexact_voronoi(false), thread_count(1), minimum_zone_count(1) {
 		initialize_features();
 	}
 
@@ -94,6 +100,7 @@ public:
 
 	void set_border(const polygon_type &border);
 	polygon_type get_border() const;
+	void set_inexact_voronoi(bool inexact_voronoi);
 	void compute_voronoi_process();
 	void release_voronoi_process();
 	bool is_voronoi_implemented() const;
@@ -113,11 +120,18 @@ public:
 	void set_zone_distance(const zone_distance_type &zone_distance);
 	void set_multidimensional_distance(const multidimensional_distance_type &multidimensional_distance);
 	void set_attribute_distances(const attribute_distance_container_type &attribute_distances);
+	void set_thread_count(size_t thread_count);
+	size_t get_thread_count() const;
+	void set_feature_distance_sampling(const feature_distance_sampling_type &feature_distance_sampling);
+	const feature_distance_sampling_type &get_feature_distance_sampling() const;
+	void set_minimum_zone_count(size_t minimum_zone_count);
+	size_t get_minimum_zone_count() const;
 	void compute_fusion_process();
 	void release_fusion_process();
 	bool is_fusion_implemented() const;
 	size_t get_fusion_size() const;
 	fusion_map_range_type get_fusion_maps(size_t begin, size_t end, bool compute_zones);
+	fusion_dendrogram_type get_fusion_dendrogram();
 
 	void set_merge(const merge_type &merge);
 	merge_type get_merge() const;
@@ -125,6 +139,9 @@ public:
 	void release_merge_process();
 	bool is_merge_implemented() const;
 	size_t get_merge_size() const;
+	size_t get_minimum_merge_zone_count() const;
+	void compute_merge_map_geometries(size_t map_index);
+	size_t get_zone_geometry_vertex_size() const;
 	merge_map_type get_merge_map(size_t map_index) const;
 
 private:
@@ -57,7 +57,10 @@
 #include <geofis/algorithm/zoning/fusion/distance/variant_multidimensional_distance.hpp>
 #include <geofis/algorithm/zoning/fusion/distance/variant_attribute_distance.hpp>
 #include <geofis/algorithm/zoning/fusion/distance/variant_feature_distance.hpp>
+#include <geofis/algorithm/zoning/pair/feature_distance_sampling.hpp>
 #include <geofis/algorithm/zoning/fusion/zone_fusion.hpp>
+#include <geofis/algorithm/zoning/fusion/fusion_dendrogram.hpp>
+#include <geofis/algorithm/zoning/fusion/zone/zone_geometry_cache.hpp>
 #include <geofis/algorithm/zoning/fusion/map/fusion_map_range.hpp>
 #include <geofis/algorithm/zoning/merge/variant_merge.hpp>
 #include <geofis/algorithm/zoning/map/map.hpp>
@@ -104,11 +107,15 @@ struct zoning_process_traits {
 
 	typedef typename variant_feature_distance_traits<multidimensional_distance_type, attribute_distance_type>::variant_feature_distance_type feature_distance_type;
 
+	typedef feature_distance_sampling feature_distance_sampling_type;
+
 	typedef zone_fusion<zone_type> zone_fusion_type;
 	typedef typename fusion_map_traits<zone_type>::fusion_map_type fusion_map_type;
 	typedef std::list<zone_fusion_type> zone_fusion_container_type;
 	typedef typename fusion_map_range_traits<zone_fusion_container_type>::fusion_map_range_type fusion_map_range_type;
 	typedef typename boost::reversed_range<const fusion_map_range_type> reverse_fusion_map_range_type;
+	typedef fusion_dendrogram fusion_dendrogram_type;
+	typedef zone_geometry_cache<zone_fusion_type> zone_geometry_cache_type;
 
 	typedef variant_merge merge_type;
 	typedef map<zone_type> merge_map_type;
@@ -0,0 +1,115 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef HCAF6C36E_6A65_45E7_97B2_91FF726B6701
+#define HCAF6C36E_6A65_45E7_97B2_91FF726B6701
+
+#include <Rcpp.h>
+#include <map>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+namespace geofis {
+
+/*
+@startuml
+
+title rcpp_zone_labeler class diagram
+
+class rcpp_zone_labeler {
+	- rows : unordered_map<string, int>
+	- first_rows : int [0..*]
+	+ <<constructor>> rcpp_zone_labeler(ids: string [0..*], points: point [0..*])
+	+ get_row_size() : size_t
+	+ label_zones(map: Map, labels: IntegerMatrix::Column)
+}
+
+note right of rcpp_zone_labeler
+	the label of a source row is the index from 1 of its zone
+	in the map zones, as the polygons of the R map,
+	or NA when the point is outside the border
+
+	the zoning keeps the first of the duplicated points,
+	the other duplicated points get its label
+end note
+
+@enduml
+*/
+
+class rcpp_zone_labeler {
+
+	typedef std::unordered_map<std::string, int> row_container_type;
+	typedef std::vector<int> first_row_container_type;
+	typedef std::pair<double, double> coordinate_type;
+
+public:
+	rcpp_zone_labeler(const Rcpp::CharacterVector &ids, const Rcpp::NumericMatrix &points) : rows(ids.size()), first_rows(ids.size()) {
+		std::map<coordinate_type, int> coordinate_rows;
+		for(int row = 0; row < ids.size(); ++row) {
+			rows[std::string(ids[row])] = row;
+			first_rows[row] = coordinate_rows.insert(std::make_pair(coordinate_type(points(row, 0), points(row, 1)), row)).first->second;
+		}
+	}
+
+	size_t get_row_size() const {
+		return first_rows.size();
+	}
+
+	template <class Map> void label_zones(const Map &map, Rcpp::IntegerMatrix::Column labels) const {
+		std::fill(labels.begin(), labels.end(), NA_INTEGER);
+		int label = 0;
+		for(const auto &zone : map.get_zones()) {
+			++label;
+			for(const auto &feature : zone.get_feature_range())
+				labels[rows.at(feature.get_id())] = label;
+		}
+		for(size_t row = 0; row < first_rows.size(); ++row)
+			labels[row] = labels[first_rows[row]];
+	}
+
+private:
+	row_container_type rows;
+	first_row_container_type first_rows;
+};
+
+} // namespace geofis
+
+#endif // HCAF6C36E_6A65_45E7_97B2_91FF726B6701
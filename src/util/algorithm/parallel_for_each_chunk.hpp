@@ -0,0 +1,101 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef PARALLEL_FOR_EACH_CHUNK_HPP_
+#define PARALLEL_FOR_EACH_CHUNK_HPP_
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <system_error>
+#include <algorithm>
+
+namespace util {
+
+//! number of chunks used by parallel_for_each_chunk to split **size** elements on **thread_count** threads
+inline size_t get_chunk_count(size_t size, size_t thread_count) {
+	return std::max<size_t>(std::min(size, thread_count), 1);
+}
+
+//! begin of the chunk **chunk** when **size** elements are split in **chunk_count** contiguous chunks
+inline size_t get_chunk_begin(size_t chunk, size_t size, size_t chunk_count) {
+	return chunk * size / chunk_count;
+}
+
+namespace detail {
+
+template <class Function> void run_chunk(const Function &function, size_t chunk, size_t size, size_t chunk_count, std::exception_ptr &exception) {
+	try {
+		function(chunk, get_chunk_begin(chunk, size, chunk_count), get_chunk_begin(chunk + 1, size, chunk_count));
+	} catch(...) {
+		exception = std::current_exception();
+	}
+}
+
+} // namespace detail
+
+/**
+ * Split [0, **size**) in get_chunk_count(**size**, **thread_count**) contiguous chunks, and call **function**(chunk, begin, end)
+ * for each chunk, the first chunk in the calling thread and the others in their own thread when available.
+ * The exception of the first failed chunk is rethrown once all the threads are joined.
+ * **function** must not call the R API.
+ */
+template <class Function> void parallel_for_each_chunk(size_t size, size_t thread_count, const Function &function) {
+	size_t chunk_count = get_chunk_count(size, thread_count);
+	std::vector<std::exception_ptr> exceptions(chunk_count);
+	std::vector<std::thread> threads;
+	threads.reserve(chunk_count - 1);
+	for(size_t chunk = 1; chunk < chunk_count; ++chunk) {
+		try {
+			threads.emplace_back(detail::run_chunk<Function>, std::cref(function), chunk, size, chunk_count, std::ref(exceptions[chunk]));
+		} catch(const std::system_error &) {
+			// no more thread available, the chunk is run in the calling thread
+			detail::run_chunk(function, chunk, size, chunk_count, exceptions[chunk]);
+		}
+	}
+	detail::run_chunk(function, 0, size, chunk_count, exceptions[0]);
+	for(std::thread &thread : threads)
+		thread.join();
+	for(const std::exception_ptr &exception : exceptions)
+		if(exception)
+			std::rethrow_exception(exception);
+}
+
+} // namespace util
+
+#endif /* PARALLEL_FOR_EACH_CHUNK_HPP_ */
@@ -44,7 +44,7 @@
 #ifdef R_PACKAGE
 
 #define UTIL_ASSERT(condition) ((void)0)
-#define UTIL_ALLEGE(condition) ((void)0)
+#define UTIL_ALLEGE(condition) ((void)(condition))
 
 #else // NOT R_PACKAGE
 
@@ -40,10 +40,9 @@
 #define EUCLIDEAN_DISTANCE_HPP_
 
 #include <cmath>
-#include <algorithm>
 #include <util/assert.hpp>
-#include <boost/range/numeric.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <util/functional/distance/minkowski_norm.hpp>
+#include <boost/range.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/type_traits/is_convertible.hpp>
 
@@ -57,29 +56,16 @@ template <class T> struct euclidean_distance {
 		return std::abs(lhs - rhs);
 	}
 
-	struct element_distance {
-
-		typedef T result_type;
-
-		result_type operator()(T lhs, T rhs) const {
-			return std::pow(lhs - rhs, 2);
-		}
-
-		result_type operator()(T x) const {
-			return std::pow(x, 2);
-		}
-	};
-
 	template <class Range1, class Range2> result_type operator()(const Range1 &range1, const Range2 &range2) const {
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range1>::type, T>));
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range2>::type, T>));
 		UTIL_REQUIRE(boost::size(range1) == boost::size(range2));
-		return std::sqrt(boost::inner_product(range1, range2, (T)0, std::plus<T>(), element_distance()));
+		return std::sqrt(squared_euclidean_norm<T>(make_difference_range<T>(range1, range2)));
 	}
 
 	template <class Range> result_type operator()(const Range &range) const {
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range>::type, T>));
-		return std::sqrt(boost::accumulate(boost::adaptors::transform(range, element_distance()), (T)0));
+		return std::sqrt(squared_euclidean_norm<T>(range));
 	}
 };
 
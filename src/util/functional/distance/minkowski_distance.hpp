@@ -39,11 +39,9 @@
 #ifndef MINKOWSKI_DISTANCE_HPP_
 #define MINKOWSKI_DISTANCE_HPP_
 
-#include <cmath>
-#include <algorithm>
 #include <util/assert.hpp>
-#include <boost/range/numeric.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <util/functional/distance/minkowski_norm.hpp>
+#include <boost/range.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/type_traits/is_convertible.hpp>
 
@@ -53,43 +51,31 @@ template <class T> struct minkowski_distance {
 
 	typedef T result_type;
 
-	minkowski_distance() : power(2) {}
-	minkowski_distance(T power) : power(power) {}
-
-	struct element_distance {
-
-		typedef T result_type;
-
-		element_distance(T power) : power(power) {}
-
-		result_type operator()(T lhs, T rhs) const {
-			return std::pow(std::abs(lhs - rhs), power);
-		}
-
-		result_type operator()(T x) const {
-			return std::pow(std::abs(x), power);
-		}
-
-		T power;
-	};
+	minkowski_distance() : norm(2) {}
+	minkowski_distance(T power) : norm(power) {}
 
 	template <class Range1, class Range2> result_type operator()(const Range1 &range1, const Range2 &range2) const {
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range1>::type, T>));
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range2>::type, T>));
 		UTIL_REQUIRE(boost::size(range1) == boost::size(range2));
-		return std::pow(boost::inner_product(range1, range2, (T)0, std::plus<T>(), element_distance(power)), (T)1 / power);
+		return norm(make_difference_range<T>(range1, range2));
 	}
 
 	template <class Range> result_type operator()(const Range &range) const {
 		BOOST_MPL_ASSERT((boost::is_convertible<typename boost::range_value<Range>::type, T>));
-		return std::pow(boost::accumulate(boost::adaptors::transform(range, element_distance(power)), (T)0), (T)1 / power);
+		return norm(range);
+	}
+
+	T get_power() const {
+		return norm.get_power();
 	}
 
-	bool operator==(const minkowski_distance &other) {
-		return power == other.power;
+	bool operator==(const minkowski_distance &other) const {
+		return get_power() == other.get_power();
 	}
 
-	T power;
+private:
+	minkowski_norm<T> norm;
 };
 
 } // namespace util
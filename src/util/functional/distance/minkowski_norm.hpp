@@ -0,0 +1,169 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef MINKOWSKI_NORM_HPP_
+#define MINKOWSKI_NORM_HPP_
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <boost/range/numeric.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <util/range/zipped_with_range.hpp>
+
+namespace util {
+
+template <class T> struct absolute_value {
+
+	typedef T result_type;
+
+	result_type operator()(T x) const {
+		return std::abs(x);
+	}
+};
+
+template <class T> struct square_value {
+
+	typedef T result_type;
+
+	result_type operator()(T x) const {
+		return x * x;
+	}
+};
+
+template <class T> struct power_value {
+
+	typedef T result_type;
+
+	power_value(T power) : power(power) {}
+
+	result_type operator()(T x) const {
+		return std::pow(std::abs(x), power);
+	}
+
+	T power;
+};
+
+template <class T> struct difference_value {
+
+	typedef T result_type;
+
+	result_type operator()(T lhs, T rhs) const {
+		return lhs - rhs;
+	}
+};
+
+template <class T> struct maximum_value {
+
+	typedef T result_type;
+
+	result_type operator()(T lhs, T rhs) const {
+		return std::max(lhs, rhs);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T, class Range> inline T manhattan_norm(const Range &range) {
+	return boost::accumulate(boost::adaptors::transform(range, absolute_value<T>()), (T)0);
+}
+
+template <class T, class Range> inline T squared_euclidean_norm(const Range &range) {
+	return boost::accumulate(boost::adaptors::transform(range, square_value<T>()), (T)0);
+}
+
+template <class T, class Range> inline T chebyshev_norm(const Range &range) {
+	return boost::accumulate(boost::adaptors::transform(range, absolute_value<T>()), (T)0, maximum_value<T>());
+}
+
+template <class T, class Range> inline T power_sum(const Range &range, T power) {
+	return boost::accumulate(boost::adaptors::transform(range, power_value<T>(power)), (T)0);
+}
+
+template <class T, class Range1, class Range2> inline auto make_difference_range(const Range1 &range1, const Range2 &range2) {
+	return make_zipped_with(difference_value<T>(), range1, range2);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// the powers 1, 2 and infinity avoid std::pow, the elements are accumulated in the range order,
+// the power 2 gives the euclidean norm, the power infinity gives the chebyshev norm
+template <class T> class minkowski_norm {
+
+public:
+	typedef T result_type;
+
+	minkowski_norm(T power) : power(power), power_kind(get_power_kind(power)) {}
+
+	T get_power() const {
+		return power;
+	}
+
+	template <class Range> result_type operator()(const Range &range) const {
+		switch(power_kind) {
+		case manhattan_power:
+			return manhattan_norm<T>(range);
+		case euclidean_power:
+			return std::sqrt(squared_euclidean_norm<T>(range));
+		case chebyshev_power:
+			return chebyshev_norm<T>(range);
+		default:
+			return std::pow(power_sum<T>(range, power), (T)1 / power);
+		}
+	}
+
+private:
+	enum power_kind_type { manhattan_power, euclidean_power, chebyshev_power, generic_power };
+
+	T power;
+	power_kind_type power_kind;
+
+	static power_kind_type get_power_kind(T power) {
+		if(power == (T)1)
+			return manhattan_power;
+		if(power == (T)2)
+			return euclidean_power;
+		if(power == std::numeric_limits<T>::infinity())
+			return chebyshev_power;
+		return generic_power;
+	}
+};
+
+} // namespace util
+
+#endif /* MINKOWSKI_NORM_HPP_ */
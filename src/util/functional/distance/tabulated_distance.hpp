@@ -0,0 +1,117 @@
+/**
+ * GeoFIS R package
+ *
+ * Copyright (C) 2021 INRAE
+ *
+ * Authors:
+ * 	Jean-luc Lablée - INRAE
+ * 	Serge Guillaume - INRAE
+ *
+ * License: CeCILL v2.1
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-en.html
+ * 	https://cecill.info/licences/Licence_CeCILL_V2.1-fr.html
+ *
+ * This software is governed by the CeCILL license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "https://cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights, and the successive licensors have only limited liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+#ifndef TABULATED_DISTANCE_HPP_
+#define TABULATED_DISTANCE_HPP_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <util/assert.hpp>
+
+namespace util {
+
+// tabulated_distance approximates **distance** on [0, 1] x [0, 1] with a table of (resolution + 1)^2 values,
+// the distance between two values is the bilinear interpolation of the 4 nearest table values,
+// the values outside [0, 1] are clamped, and **distance** is used until the table is built
+template <class Distance> class tabulated_distance {
+
+public:
+	typedef typename Distance::result_type result_type;
+
+	template <class DistanceArgument> tabulated_distance(const DistanceArgument &distance_argument, size_t resolution) : distance(distance_argument), resolution(resolution) {
+		UTIL_REQUIRE(resolution > 0);
+	}
+
+	Distance &get_distance() {
+		return distance;
+	}
+
+	const Distance &get_distance() const {
+		return distance;
+	}
+
+	size_t get_resolution() const {
+		return resolution;
+	}
+
+	bool is_tabulated() const {
+		return !table.empty();
+	}
+
+	//! must be called again if **distance** is modified
+	void tabulate() {
+		size_t size = resolution + 1;
+		table.resize(size * size);
+		for(size_t i = 0; i < size; ++i)
+			for(size_t j = 0; j < size; ++j)
+				table[i * size + j] = distance(get_value(i), get_value(j));
+	}
+
+	result_type operator()(double lhs, double rhs) const {
+		if(!is_tabulated())
+			return distance(lhs, rhs);
+		size_t i, j;
+		double lhs_weight = get_interpolation_weight(lhs, i);
+		double rhs_weight = get_interpolation_weight(rhs, j);
+		size_t size = resolution + 1;
+		const result_type *row = &table[i * size + j];
+		const result_type *next_row = row + size;
+		return (1. - lhs_weight) * ((1. - rhs_weight) * row[0] + rhs_weight * row[1]) + lhs_weight * ((1. - rhs_weight) * next_row[0] + rhs_weight * next_row[1]);
+	}
+
+private:
+	Distance distance;
+	size_t resolution;
+	std::vector<result_type> table;
+
+	double get_value(size_t index) const {
+		return (double)index / resolution;
+	}
+
+	// **index** is the lower table index of the interval containing **value**, the result is the position of **value** in this interval
+	double get_interpolation_weight(double value, size_t &index) const {
+		double position = std::min(std::max(value, 0.), 1.) * resolution;
+		index = std::min((size_t)std::floor(position), resolution - 1);
+		return position - index;
+	}
+};
+
+} // namespace util
+
+#endif /* TABULATED_DISTANCE_HPP_ */
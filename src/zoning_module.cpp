@@ -43,6 +43,7 @@
 #include <util/functional/distance/euclidean_distance.hpp>
 #include <util/functional/distance/minkowski_distance.hpp>
 #include <base/fuzzy_distance.hpp>
+#include <geofis/algorithm/zoning/fusion/distance/variant_attribute_distance.hpp>
 #include <geofis/algorithm/zoning/merge/size/size_merge.hpp>
 #include <geofis/algorithm/zoning/merge/area/area_merge.hpp>
 #include <zoning_wrapper.h>
@@ -76,6 +77,10 @@ bool is_mean_zone_distance(SEXP* args, int nargs) {
 	return is_s4_class(args[0], "Rcpp_mean_wrapper");
 }
 
+bool is_ward_zone_distance(SEXP* args, int nargs) {
+	return is_s4_class(args[0], "Rcpp_ward_wrapper");
+}
+
 bool is_euclidean_combine_distance(SEXP* args, int nargs) {
 	return is_s4_class(args[0], "Rcpp_euclidean_wrapper");
 }
@@ -100,12 +105,16 @@ RCPP_EXPOSED_AS(maximum<double>)
 
 RCPP_EXPOSED_AS(util::mean<double>)
 
+RCPP_EXPOSED_AS(ward_zone_distance)
+
 RCPP_EXPOSED_AS(euclidean_distance<double>)
 
 RCPP_EXPOSED_AS(minkowski_distance<double>)
 
 RCPP_EXPOSED_AS(fuzzy_distance)
 
+RCPP_EXPOSED_AS(tabulated_fuzzy_distance)
+
 RCPP_EXPOSED_AS(size_merge)
 
 RCPP_EXPOSED_AS(area_merge)
@@ -118,6 +127,7 @@ RCPP_MODULE(zoning_module) {
 	.constructor<S4>()
 	//.constructor<StringVector, NumericMatrix, NumericMatrix>()
 	.method("set_border", &zoning_wrapper::set_border)
+	.method("set_inexact_voronoi", &zoning_wrapper::set_inexact_voronoi)
 	.method("perform_voronoi", &zoning_wrapper::perform_voronoi)
 	.method("release_voronoi", &zoning_wrapper::release_voronoi)
 	.method("get_voronoi_map", &zoning_wrapper::get_voronoi_map)
@@ -128,21 +138,32 @@ RCPP_MODULE(zoning_module) {
 	.method("release_neighborhood", &zoning_wrapper::release_neighborhood)
 	.method("get_neighborhood_map", &zoning_wrapper::get_neighborhood_map)
 	.method("set_attribute_distances", &zoning_wrapper::set_attribute_distances)
+	.method("set_thread_count", &zoning_wrapper::set_thread_count)
+	.method("set_sample_size", &zoning_wrapper::set_sample_size)
+	.method("set_sample_seed", &zoning_wrapper::set_sample_seed)
+	.method("set_minimum_zone_count", &zoning_wrapper::set_minimum_zone_count)
+	.method("get_minimum_zone_count", &zoning_wrapper::get_minimum_zone_count)
 	.method("set_zone_distance", static_cast<void (zoning_wrapper::*)(const minimum<double> &)>(&zoning_wrapper::set_zone_distance), "set minimum zone distance", is_minimum_zone_distance)
 	.method("set_zone_distance", static_cast<void (zoning_wrapper::*)(const maximum<double> &)>(&zoning_wrapper::set_zone_distance), "set maximum zone distance", is_maximum_zone_distance)
 	.method("set_zone_distance", static_cast<void (zoning_wrapper::*)(const util::mean<double> &)>(&zoning_wrapper::set_zone_distance), "set mean zone distance", is_mean_zone_distance)
+	.method("set_zone_distance", static_cast<void (zoning_wrapper::*)(const ward_zone_distance &)>(&zoning_wrapper::set_zone_distance), "set ward zone distance", is_ward_zone_distance)
 	.method("set_combine_distance", static_cast<void (zoning_wrapper::*)(const euclidean_distance<double> &)>(&zoning_wrapper::set_multidimensional_distance), "set euclidean multidimensional distance", is_euclidean_combine_distance)
 	.method("set_combine_distance", static_cast<void (zoning_wrapper::*)(const minkowski_distance<double> &)>(&zoning_wrapper::set_multidimensional_distance), "set minkowski multidimensional distance", is_minkowski_combine_distance)
 	.method("perform_fusion", &zoning_wrapper::perform_fusion)
 	.method("release_fusion", &zoning_wrapper::release_fusion)
 	.method("get_fusion_size", &zoning_wrapper::get_fusion_size)
+	.method("get_fusion_dendrogram", &zoning_wrapper::get_fusion_dendrogram)
+	.method("get_fusion_zone_labels", &zoning_wrapper::get_fusion_zone_labels)
 	.method("set_merge", static_cast<void (zoning_wrapper::*)(const size_merge &)>(&zoning_wrapper::set_merge), "set size merge", is_size_merge)
 	.method("set_merge", static_cast<void (zoning_wrapper::*)(const area_merge &)>(&zoning_wrapper::set_merge), "set area merge", is_area_merge)
 	.method("perform_merge", &zoning_wrapper::perform_merge)
 	.method("release_merge", &zoning_wrapper::release_merge)
 	.method("get_merge_size", &zoning_wrapper::get_merge_size)
+	.method("precompute_merge_maps", &zoning_wrapper::precompute_merge_maps)
 	.method("get_merge_map", &zoning_wrapper::get_merge_map)
-	.method("get_merge_maps", &zoning_wrapper::get_merge_maps);
+	.method("get_merge_maps", &zoning_wrapper::get_merge_maps)
+	.method("get_merge_zone_labels", &zoning_wrapper::get_merge_zone_labels)
+	.method("get_zone_geometry_vertex_size", &zoning_wrapper::get_zone_geometry_vertex_size);
 
 	class_<minimum<double> >("minimum_wrapper")
 	.constructor();
@@ -153,6 +174,9 @@ RCPP_MODULE(zoning_module) {
 	class_<util::mean<double> >("mean_wrapper")
 	.constructor();
 
+	class_<ward_zone_distance>("ward_wrapper")
+	.constructor();
+
 	class_<euclidean_distance<double> >("euclidean_wrapper")
 	.constructor();
 
@@ -162,6 +186,9 @@ RCPP_MODULE(zoning_module) {
 	class_<fuzzy_distance>("fuzzy_wrapper")
 	.constructor<const fisin_wrapper &>();
 
+	class_<tabulated_fuzzy_distance>("tabulated_fuzzy_wrapper")
+	.constructor<const fisin_wrapper &, int>();
+
 	class_<size_merge>("size_wrapper")
 	.constructor<int>();
 
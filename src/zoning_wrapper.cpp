@@ -37,12 +37,17 @@
  * knowledge of the CeCILL license and that you accept its terms.
  */
 #include <zoning_wrapper.h>
+#include <map>
 #include <vector>
+#include <functional>
 #include <boost/format.hpp>
 #include <boost/icl/closed_interval.hpp>
 #include <boost/icl/continuous_interval.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/find_if.hpp>
+#include <boost/range/algorithm/for_each.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/algorithm/unique.hpp>
 #include <rcpp/vector_range.hpp>
 #include <geofis/geometry/geometrical.hpp>
 #include <geofis/process/zoning/zoning_process.hpp>
@@ -52,6 +57,7 @@
 #include <geofis/rcpp/process/zoning/voronoi/voronoi_map.hpp>
 #include <geofis/rcpp/process/zoning/neighborhood/neighborhood_map.hpp>
 #include <geofis/rcpp/process/zoning/map.hpp>
+#include <geofis/rcpp/process/zoning/zone_labeler.hpp>
 
 using namespace Rcpp;
 using namespace std;
@@ -81,6 +87,8 @@ RCPP_EXPOSED_AS(minkowski_distance<double>)
 
 RCPP_EXPOSED_AS(fuzzy_distance)
 
+RCPP_EXPOSED_AS(tabulated_fuzzy_distance)
+
 struct attribute_distance_maker {
 
 	typedef attribute_distance_type result_type;
@@ -93,6 +101,8 @@ struct attribute_distance_maker {
 			}
 			else if(s4.is("Rcpp_fuzzy_wrapper"))
 				return as<fuzzy_distance>(sexp);
+			else if(s4.is("Rcpp_tabulated_fuzzy_wrapper"))
+				return as<tabulated_fuzzy_distance>(sexp);
 			else
 				stop("unsupported attribute distance");
 		} else if(Rf_isNull(sexp)) {
@@ -142,6 +152,10 @@ void zoning_wrapper::set_border(S4 border) {
 	zp->set_border(make_polygon_2<kernel_type>(polygon_list[0]));
 }
 
+void zoning_wrapper::set_inexact_voronoi(bool inexact_voronoi) {
+	zp->set_inexact_voronoi(inexact_voronoi);
+}
+
 void zoning_wrapper::perform_voronoi() {
 	if(!zp->is_voronoi_implemented())
 		zp->compute_voronoi_process();
@@ -192,6 +206,32 @@ void zoning_wrapper::set_attribute_distances(List attribute_distance_list) {
 	zp->set_attribute_distances(attribute_distances);
 }
 
+void zoning_wrapper::set_thread_count(int thread_count) {
+	if(thread_count < 1)
+		stop("thread count must be a positive integer");
+	zp->set_thread_count(thread_count);
+}
+
+void zoning_wrapper::set_sample_size(int sample_size) {
+	if(sample_size < 0)
+		stop("sample size must be a positive integer");
+	zp->set_feature_distance_sampling(feature_distance_sampling(sample_size, zp->get_feature_distance_sampling().get_seed()));
+}
+
+void zoning_wrapper::set_sample_seed(int sample_seed) {
+	zp->set_feature_distance_sampling(feature_distance_sampling(zp->get_feature_distance_sampling().get_sample_size(), sample_seed));
+}
+
+void zoning_wrapper::set_minimum_zone_count(int minimum_zone_count) {
+	if(minimum_zone_count < 1)
+		stop("minimum zone count must be a positive integer");
+	zp->set_minimum_zone_count(minimum_zone_count);
+}
+
+int zoning_wrapper::get_minimum_zone_count() const {
+	return zp->get_minimum_zone_count();
+}
+
 void zoning_wrapper::set_zone_distance(const maximum<double> &maximum_distance) {
 	zp->set_zone_distance(maximum_distance);
 }
@@ -204,6 +244,10 @@ void zoning_wrapper::set_zone_distance(const util::mean<double> &mean_distance)
 	zp->set_zone_distance(mean_distance);
 }
 
+void zoning_wrapper::set_zone_distance(const ward_zone_distance &ward_distance) {
+	zp->set_zone_distance(ward_distance);
+}
+
 void zoning_wrapper::set_multidimensional_distance(const euclidean_distance<double> &euclidean_distance) {
 	zp->set_multidimensional_distance(euclidean_distance);
 }
@@ -226,6 +270,60 @@ int zoning_wrapper::get_fusion_size () {
 	return zp->is_fusion_implemented() ? zp->get_fusion_size() : NA_INTEGER;
 }
 
+static rcpp_zone_labeler make_zone_labeler(S4 source) {
+	NumericMatrix points = source.slot("coords");
+	DataFrame data_frame = wrap(source.slot("data"));
+	Function row_names("rownames");
+	CharacterVector ids = row_names(data_frame);
+	return rcpp_zone_labeler(ids, points);
+}
+
+// the fusion map i has **bounded_feature_size** - i - 1 zones, all the columns are labeled in one forward pass over the fusion maps, without any zone geometry,
+// the fusion map iterator is only dereferenced at the labeled maps
+Nullable<IntegerMatrix> zoning_wrapper::get_fusion_zone_labels(IntegerVector number_of_zones) {
+	if(zp->is_fusion_implemented()) {
+		size_t zone_size = zp->get_bounded_feature_size();
+		closed_interval<size_t> fusion_interval(zone_size - zp->get_fusion_size(), zone_size - 1);
+		multimap<size_t, int> fusion_map_columns;
+		for(int column = 0; column < number_of_zones.size(); column++) {
+			if(number_of_zones[column] == NA_INTEGER || !contains(fusion_interval, size_t(number_of_zones[column])))
+				stop(str(format("number_of_zones must be in range %1%") % fusion_interval));
+			fusion_map_columns.insert(make_pair(zone_size - number_of_zones[column] - 1, column));
+		}
+		rcpp_zone_labeler zone_labeler = make_zone_labeler(source);
+		IntegerMatrix labels(zone_labeler.get_row_size(), number_of_zones.size());
+		if(fusion_map_columns.empty())
+			return labels;
+		auto fusion_maps = zp->get_fusion_maps(0, fusion_map_columns.rbegin()->first + 1, false);
+		auto fusion_map_iterator = boost::begin(fusion_maps);
+		size_t fusion_map_index = 0;
+		for(auto fusion_map_column = fusion_map_columns.begin(); fusion_map_column != fusion_map_columns.end(); ++fusion_map_iterator, ++fusion_map_index) {
+			if(fusion_map_column->first != fusion_map_index)
+				continue;
+			auto fusion_map = *fusion_map_iterator;
+			for(; fusion_map_column != fusion_map_columns.end() && fusion_map_column->first == fusion_map_index; ++fusion_map_column)
+				zone_labeler.label_zones(fusion_map, labels.column(fusion_map_column->second));
+		}
+		return labels;
+	} else
+		return R_NilValue;
+}
+
+// the merge matrix is copied from the column major merges of the fusion dendrogram, without any fusion map
+Nullable<List> zoning_wrapper::get_fusion_dendrogram() {
+	if(zp->is_fusion_implemented()) {
+		auto fusion_dendrogram = zp->get_fusion_dendrogram();
+		auto &merges = fusion_dendrogram.get_merges();
+		auto &heights = fusion_dendrogram.get_heights();
+		auto &distances = fusion_dendrogram.get_distances();
+		auto &labels = fusion_dendrogram.get_labels();
+		auto order = fusion_dendrogram.get_order();
+		IntegerMatrix merge(fusion_dendrogram.get_merge_size(), 2, boost::begin(merges));
+		return List::create(_["merge"] = merge, _["height"] = NumericVector(boost::begin(heights), boost::end(heights)), _["distance"] = NumericVector(boost::begin(distances), boost::end(distances)), _["order"] = IntegerVector(boost::begin(order), boost::end(order)), _["labels"] = CharacterVector(boost::begin(labels), boost::end(labels)));
+	} else
+		return R_NilValue;
+}
+
 void zoning_wrapper::check_size_merge(const size_merge &size_merge) const {
 	Function nrow("nrow");
 	int max_size = as<int>(nrow(source));
@@ -272,13 +370,34 @@ int zoning_wrapper::get_merge_size() {
 	return zp->is_merge_implemented() ? zp->get_merge_size() : NA_INTEGER;
 }
 
+size_t zoning_wrapper::get_merge_map_index(size_t number_of_zones) const {
+	size_t merge_size = zp->get_merge_size();
+	// the first merge map has more than 1 zone when the fusion stops at a minimum zone count
+	size_t minimum_merge_zone_count = zp->get_minimum_merge_zone_count();
+	closed_interval<size_t> merge_interval(minimum_merge_zone_count, minimum_merge_zone_count + merge_size - 1);
+	if(!contains(merge_interval, number_of_zones))
+		stop(str(format("number_of_zones must be in range %1%") % merge_interval));
+	return number_of_zones - minimum_merge_zone_count;
+}
+
+bool zoning_wrapper::precompute_merge_maps(IntegerVector number_of_zones) {
+	if(zp->is_merge_implemented()) {
+		auto merge_map_index_range = number_of_zones | transformed([this](int n) { return this->get_merge_map_index(n); });
+		vector<size_t> merge_map_indexes(boost::begin(merge_map_index_range), boost::end(merge_map_index_range));
+		// from the map with the most zones, so the zones of the next maps are joined from the cached geometries
+		boost::sort(merge_map_indexes, std::greater<size_t>());
+		boost::for_each(boost::unique(merge_map_indexes), [this](size_t merge_map_index) { zp->compute_merge_map_geometries(merge_map_index); });
+		return true;
+	} else
+		return false;
+}
+
 Nullable<S4> zoning_wrapper::get_merge_map(size_t number_of_zones) {
 	if(zp->is_merge_implemented()) {
-		size_t merge_size = zp->get_merge_size();
-		closed_interval<size_t> merge_interval(1, merge_size);
-		if(!contains(merge_interval, number_of_zones))
-			stop(str(format("number_of_zones must be in range %1%") % merge_interval));
-		auto merge_map = zp->get_merge_map(number_of_zones - 1);
+		size_t merge_map_index = get_merge_map_index(number_of_zones);
+		// the merged zones are copied with the geometries of the fusion zones, each joined once from the cached geometries of its zones
+		zp->compute_merge_map_geometries(merge_map_index);
+		auto merge_map = zp->get_merge_map(merge_map_index);
 		Function col_names("colnames");
 		return make_rcpp_map(merge_map, source.slot("proj4string"), col_names(source.slot("data")));
 	} else
@@ -287,8 +406,24 @@ Nullable<S4> zoning_wrapper::get_merge_map(size_t number_of_zones) {
 
 Nullable<List> zoning_wrapper::get_merge_maps(IntegerVector number_of_zones) {
 	if(zp->is_merge_implemented()) {
+		precompute_merge_maps(number_of_zones);
 		auto merge_map_range = number_of_zones | transformed([this](int n) { return this->get_merge_map(n); });
 		return List(boost::begin(merge_map_range), boost::end(merge_map_range));
 	} else
 		return R_NilValue;
 }
+
+Nullable<IntegerMatrix> zoning_wrapper::get_merge_zone_labels(IntegerVector number_of_zones) {
+	if(zp->is_merge_implemented()) {
+		rcpp_zone_labeler zone_labeler = make_zone_labeler(source);
+		IntegerMatrix labels(zone_labeler.get_row_size(), number_of_zones.size());
+		for(int column = 0; column < number_of_zones.size(); column++)
+			zone_labeler.label_zones(zp->get_merge_map(get_merge_map_index(number_of_zones[column])), labels.column(column));
+		return labels;
+	} else
+		return R_NilValue;
+}
+
+int zoning_wrapper::get_zone_geometry_vertex_size() {
+	return zp->get_zone_geometry_vertex_size();
+}
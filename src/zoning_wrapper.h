@@ -61,6 +61,8 @@ class zoning_wrapper {
 	void check_area_merge(const geofis::area_merge &area_merge) const;
 	void check_merge(const merge_type &merge) const;
 
+	size_t get_merge_map_index(size_t number_of_zones) const;
+
 	friend struct merge_checker;
 
 public:
@@ -69,6 +71,8 @@ public:
 
 	void set_border(Rcpp::S4 border);
 
+	void set_inexact_voronoi(bool inexact_voronoi);
+
 	void perform_voronoi();
 	void release_voronoi();
 
@@ -86,9 +90,18 @@ public:
 
 	void set_attribute_distances(Rcpp::List attribute_distance_list);
 
+	void set_thread_count(int thread_count);
+
+	void set_sample_size(int sample_size);
+	void set_sample_seed(int sample_seed);
+
+	void set_minimum_zone_count(int minimum_zone_count);
+	int get_minimum_zone_count() const;
+
 	void set_zone_distance(const util::maximum<double> &maximum_distance);
 	void set_zone_distance(const util::minimum<double> &minimum_distance);
 	void set_zone_distance(const util::mean<double> &mean_distance);
+	void set_zone_distance(const geofis::ward_zone_distance &ward_distance);
 
 	void set_multidimensional_distance(const util::euclidean_distance<double> &euclidean_distance);
 	void set_multidimensional_distance(const util::minkowski_distance<double> &minkowski_distance);
@@ -97,6 +110,8 @@ public:
 	void release_fusion();
 
 	int get_fusion_size();
+	Rcpp::Nullable<Rcpp::List> get_fusion_dendrogram();
+	Rcpp::Nullable<Rcpp::IntegerMatrix> get_fusion_zone_labels(Rcpp::IntegerVector number_of_zones);
 
 	void set_merge(const geofis::size_merge &size_merge);
 	void set_merge(const geofis::area_merge &area_merge);
@@ -106,8 +121,11 @@ public:
 
 	int get_merge_size();
 
+	bool precompute_merge_maps(Rcpp::IntegerVector number_of_zones);
 	Rcpp::Nullable<Rcpp::S4> get_merge_map(size_t number_of_zones);
 	Rcpp::Nullable<Rcpp::List> get_merge_maps(Rcpp::IntegerVector number_of_zones);
+	Rcpp::Nullable<Rcpp::IntegerMatrix> get_merge_zone_labels(Rcpp::IntegerVector number_of_zones);
+	int get_zone_geometry_vertex_size();
 };
 
 #endif // H90F4A34E_CFD8_491B_A582_852DCF44D0AE